@@ -245,7 +245,7 @@ bool btc_check_script_address(const uint8_t *script,
   }
   uint8_t offset = (SCRIPT_TYPE_P2PKH == type) ? 3 : 2;
 
-  hasher_Raw(HASHER_SHA2_RIPEMD, public_key, BTC_SHORT_PUB_KEY_SIZE, digest);
+  hash160_33(public_key, digest);
   return (memcmp(digest, &script[offset], RIPEMD160_DIGEST_LENGTH) == 0);
 }
 
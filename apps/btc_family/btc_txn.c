@@ -60,12 +60,14 @@
  * INCLUDES
  *****************************************************************************/
 
+#include "background_jobs.h"
 #include "btc_api.h"
 #include "btc_helpers.h"
 #include "btc_priv.h"
 #include "btc_script.h"
 #include "btc_txn_helpers.h"
 #include "constant_texts.h"
+#include "progress_api.h"
 #include "reconstruct_wallet_flow.h"
 #include "status_api.h"
 #include "ui_core_confirm.h"
@@ -91,6 +93,21 @@
 
 typedef btc_sign_txn_signature_response_signature_t scrip_sig_t;
 
+typedef struct {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  bool status;
+} input_digest_t;
+
+/**
+ * State of the background job computing the sighash digest of each input
+ * while the user reviews the transaction
+ */
+typedef struct {
+  bool cache_ready;
+  uint32_t next_input;
+  input_digest_t *digests;
+} digest_job_ctx_t;
+
 /*****************************************************************************
  * STATIC FUNCTION PROTOTYPES
  *****************************************************************************/
@@ -211,6 +228,23 @@ static bool fetch_valid_output(btc_query_t *query);
  */
 static bool get_user_verification();
 
+/**
+ * @brief Computes one piece of the input digests in the background
+ * @details The first step fills the segwit hashes cache; each of the following
+ * steps computes the digest of one input. Only public data is involved.
+ *
+ * @param arg Reference to the digest_job_ctx_t instance
+ *
+ * @return bool Indicating if the digests of all the inputs are computed
+ */
+static bool digest_job_step(void *arg);
+
+/**
+ * @brief Schedules the computation of the input digests in the idle time of the
+ * user verification. The job is collected by sign_input().
+ */
+static void schedule_input_digests(void);
+
 /**
  * @brief Validates the change output for an exact match with wallet's derived
  * change address.
@@ -266,6 +300,8 @@ static bool send_script_sig(btc_query_t *query, const scrip_sig_t *sigs);
  *****************************************************************************/
 
 static btc_txn_context_t *btc_txn_context = NULL;
+static background_job_t digest_job = {0};
+static digest_job_ctx_t digest_job_ctx = {0};
 
 /*****************************************************************************
  * GLOBAL VARIABLES
@@ -466,11 +502,43 @@ static bool fetch_valid_output(btc_query_t *query) {
   return true;
 }
 
+static bool digest_job_step(void *arg) {
+  digest_job_ctx_t *ctx = (digest_job_ctx_t *)arg;
+  const uint32_t input_count = btc_txn_context->metadata.input_count;
+
+  if (!ctx->cache_ready) {
+    // populate hashes cache for segwit transaction types
+    btc_segwit_init_cache(btc_txn_context);
+    ctx->cache_ready = true;
+  } else {
+    input_digest_t *entry = &ctx->digests[ctx->next_input];
+    entry->status =
+        btc_digest_input(btc_txn_context, ctx->next_input, entry->digest);
+    ctx->next_input++;
+  }
+  return ctx->next_input >= input_count;
+}
+
+static void schedule_input_digests(void) {
+  const uint32_t input_count = btc_txn_context->metadata.input_count;
+
+  digest_job_ctx.cache_ready = false;
+  digest_job_ctx.next_input = 0;
+  digest_job_ctx.digests =
+      (input_digest_t *)malloc(sizeof(input_digest_t) * input_count);
+  ASSERT(NULL != digest_job_ctx.digests);
+  memzero(digest_job_ctx.digests, sizeof(input_digest_t) * input_count);
+  background_job_submit(&digest_job, digest_job_step, &digest_job_ctx);
+}
+
 static bool get_user_verification() {
   char title[20] = "";
   char value[100] = "";
   char address[100] = "";
 
+  // the digests are computed while the user goes through the screens
+  schedule_input_digests();
+
   for (int idx = 0; idx < btc_txn_context->metadata.output_count; idx++) {
     btc_sign_txn_output_t *output = &btc_txn_context->outputs[idx];
     btc_sign_txn_output_script_pub_key_t *script = &output->script_pub_key;
@@ -549,6 +617,7 @@ static bool sign_input(scrip_sig_t *signatures) {
   uint8_t buffer[64] = {0};
   HDNode node = {0};
   HDNode t_node = {0};
+  rfc6979_key_state key = {0};
   bool status = false;
   const uint32_t *hd_path = btc_txn_context->init_info.derivation_path;
   const ecdsa_curve *curve = get_curve_by_name(SECP256K1_NAME)->params;
@@ -560,9 +629,9 @@ static bool sign_input(scrip_sig_t *signatures) {
 
   set_app_flow_status(BTC_SIGN_TXN_STATUS_SEED_GENERATED);
 
-  // populate hashes cache for segwit transaction types
-  btc_segwit_init_cache(btc_txn_context);
-  if (!derive_hdnode_from_path(hd_path, 3, SECP256K1_NAME, buffer, &node) ||
+  // complete whatever part of the input digests is left
+  if (!background_job_finish(&digest_job) ||
+      !derive_hdnode_from_path(hd_path, 3, SECP256K1_NAME, buffer, &node) ||
       false == validate_change_address(&node)) {
     btc_send_error(ERROR_COMMON_ERROR_CORRUPT_DATA_TAG,
                    ERROR_DATA_FLOW_INVALID_DATA);
@@ -572,15 +641,31 @@ static bool sign_input(scrip_sig_t *signatures) {
   }
 
   status = true;
+  progress_api_start(ui_text_processing);
   for (int idx = 0; idx < btc_txn_context->metadata.input_count; idx++) {
-    // generate the input digest and respective private key
-    status = btc_digest_input(btc_txn_context, idx, buffer);
-    memcpy(&t_node, &node, sizeof(HDNode));
-    hdnode_private_ckd(&t_node, btc_txn_context->inputs[idx].change_index);
-    hdnode_private_ckd(&t_node, btc_txn_context->inputs[idx].address_index);
-    hdnode_fill_public_key(&t_node);
-    ecdsa_sign_digest(
-        curve, t_node.private_key, buffer, signatures[idx].bytes, NULL, NULL);
+    if (!progress_api_yield(idx, btc_txn_context->metadata.input_count)) {
+      // P0 event occurred; it is handled once the flow returns
+      status = false;
+      break;
+    }
+
+    // pick the input digest and generate the respective private key; inputs
+    // spending from the same address as the previous one reuse its key
+    status = digest_job_ctx.digests[idx].status;
+    memcpy(buffer, digest_job_ctx.digests[idx].digest, SHA256_DIGEST_LENGTH);
+    if (0 == idx ||
+        btc_txn_context->inputs[idx].change_index !=
+            btc_txn_context->inputs[idx - 1].change_index ||
+        btc_txn_context->inputs[idx].address_index !=
+            btc_txn_context->inputs[idx - 1].address_index) {
+      memcpy(&t_node, &node, sizeof(HDNode));
+      hdnode_private_ckd(&t_node, btc_txn_context->inputs[idx].change_index);
+      hdnode_private_ckd(&t_node, btc_txn_context->inputs[idx].address_index);
+      hdnode_fill_public_key(&t_node);
+      init_rfc6979_key(t_node.private_key, &key);
+    }
+    ecdsa_sign_digest_prepared(
+        curve, &key, buffer, signatures[idx].bytes, NULL, NULL);
     signatures[idx].size = btc_sig_to_script_sig(
         signatures[idx].bytes, t_node.public_key, signatures[idx].bytes);
     if (0 == signatures[idx].size || false == status) {
@@ -590,8 +675,10 @@ static bool sign_input(scrip_sig_t *signatures) {
       break;
     }
   }
+  progress_api_stop();
   memzero(&node, sizeof(HDNode));
   memzero(&t_node, sizeof(HDNode));
+  memzero(&key, sizeof(key));
   memzero(buffer, sizeof(buffer));
   return status;
 }
@@ -628,6 +715,11 @@ void btc_sign_transaction(btc_query_t *query) {
     delay_scr_init(ui_text_check_cysync, DELAY_TIME);
   }
 
+  background_job_cancel(&digest_job);
+  if (NULL != digest_job_ctx.digests) {
+    free(digest_job_ctx.digests);
+    digest_job_ctx.digests = NULL;
+  }
   if (NULL != btc_txn_context && NULL != btc_txn_context->inputs) {
     free(btc_txn_context->inputs);
   }
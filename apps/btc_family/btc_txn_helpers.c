@@ -269,7 +269,7 @@ STATIC void calculate_p2pkh_digest(const btc_txn_context_t *context,
 
   // double hash
   sha256_Final(&sha_256_ctx, digest);
-  sha256_Raw(digest, 32, digest);
+  sha256_32(digest, digest);
   memzero(&sha_256_ctx, sizeof(sha_256_ctx));
 }
 
@@ -323,7 +323,7 @@ STATIC bool calculate_p2wpkh_digest(const btc_txn_context_t *context,
 
   // double hash
   sha256_Final(&sha_256_ctx, digest);
-  sha256_Raw(digest, 32, digest);
+  sha256_32(digest, digest);
   memzero(&sha_256_ctx, sizeof(sha_256_ctx));
   return true;
 }
@@ -381,7 +381,7 @@ int btc_verify_input(const uint8_t *raw_txn,
   // locktime (last 4 bytes)
   memcpy(txn_data + offset - start_offset + 4, raw_txn + size - 4, 4);
   sha256_Raw(txn_data, offset - start_offset + 4 + 4, hash);
-  sha256_Raw(hash, sizeof(hash), hash);
+  sha256_32(hash, hash);
   // verify input txn hash
   if (memcmp(hash, input->prev_txn_hash, sizeof(input->prev_txn_hash)) != 0) {
     return 2;
@@ -436,7 +436,7 @@ void btc_segwit_init_cache(btc_txn_context_t *context) {
   }
   // double hash
   sha256_Final(&sha_256_ctx, segwit_cache->hash_prevouts);
-  sha256_Raw(segwit_cache->hash_prevouts, 32, segwit_cache->hash_prevouts);
+  sha256_32(segwit_cache->hash_prevouts, segwit_cache->hash_prevouts);
   sha256_Init(&sha_256_ctx);
 
   // calculate double SHA256 of the input sequences
@@ -446,14 +446,14 @@ void btc_segwit_init_cache(btc_txn_context_t *context) {
   }
   // double hash
   sha256_Final(&sha_256_ctx, segwit_cache->hash_sequence);
-  sha256_Raw(segwit_cache->hash_sequence, 32, segwit_cache->hash_sequence);
+  sha256_32(segwit_cache->hash_sequence, segwit_cache->hash_sequence);
   sha256_Init(&sha_256_ctx);
 
   // calculate double SHA256 of the output UTXOs
   digest_outputs(context, &sha_256_ctx);
   // double hash
   sha256_Final(&sha_256_ctx, segwit_cache->hash_outputs);
-  sha256_Raw(segwit_cache->hash_outputs, 32, segwit_cache->hash_outputs);
+  sha256_32(segwit_cache->hash_outputs, segwit_cache->hash_outputs);
 
   segwit_cache->filled = true;
   memzero(&sha_256_ctx, sizeof(sha_256_ctx));
@@ -188,6 +188,8 @@ bool evm_get_query(evm_query_t *query, pb_size_t exp_query_tag) {
           event.usb_event.p_msg, event.usb_event.msg_size, query)) {
     return false;
   }
+  // the host can upload its next query while this one is processed
+  usb_release_event_buffer();
 
   if (!check_evm_query(query, exp_query_tag)) {
     return false;
@@ -113,20 +113,6 @@ static inline bool is_bip44_hd_path(const uint32_t *path, uint32_t depth);
  */
 static inline bool is_account_hd_path(const uint32_t *path, uint32_t depth);
 
-/**
- * @brief This function calculates the digest of ETH sign or Personal sign data
- * using the Keccak-256 algorithm.
- *
- * @param[in] msg_data A pointer to the data that needs to be hashed.
- * @param[in] msg_data_size The size of the message data in bytes.
- * @param[out] digest_out A pointer to a buffer where the computed digest will
- * be stored.
- *
- * @return bool value indicating hash calculation status.
- */
-static bool evm_get_personal_data_digest(uint8_t *msg_data,
-                                         uint32_t msg_data_size,
-                                         uint8_t *digest_out);
 /*****************************************************************************
  * STATIC VARIABLES
  *****************************************************************************/
@@ -157,31 +143,6 @@ static inline bool is_account_hd_path(const uint32_t *path, uint32_t depth) {
          0 == path[3] && is_non_hardened(path[4]);
 }
 
-static bool evm_get_personal_data_digest(uint8_t *msg_data,
-                                         uint32_t msg_data_size,
-                                         uint8_t *digest_out) {
-  if (NULL == msg_data || NULL == digest_out || 0 == msg_data_size) {
-    return false;
-  }
-
-  char size_string[256] = {0};
-  uint8_t size_string_size = 0;
-  SHA3_CTX ctx = {0};
-
-  keccak_256_Init(&ctx);
-
-  size_string_size =
-      snprintf(size_string, sizeof(size_string), "%ld", msg_data_size);
-
-  keccak_Update(&ctx,
-                (const uint8_t *)ETH_PERSONAL_SIGN_IDENTIFIER,
-                sizeof(ETH_PERSONAL_SIGN_IDENTIFIER) - 1);
-  keccak_Update(&ctx, (const uint8_t *)size_string, size_string_size);
-  keccak_Update(&ctx, (const uint8_t *)msg_data, msg_data_size);
-
-  keccak_Final(&ctx, digest_out);
-  return true;
-}
 /*****************************************************************************
  * GLOBAL FUNCTIONS
  *****************************************************************************/
@@ -202,6 +163,32 @@ bool evm_derivation_path_guard(const uint32_t *path, uint32_t depth) {
   return false;
 }
 
+void evm_init_msg_data_digest(evm_sign_msg_context_t *ctx) {
+  char size_string[11] = {0};
+  uint8_t size_string_size = 0;
+
+  keccak_256_Init(&(ctx->msg_data_hash_ctx));
+
+  // The length prefix is known upfront from the initiate request
+  size_string_size = snprintf(size_string,
+                              sizeof(size_string),
+                              "%lu",
+                              (unsigned long)ctx->init.total_msg_size);
+
+  keccak_Update(&(ctx->msg_data_hash_ctx),
+                (const uint8_t *)ETH_PERSONAL_SIGN_IDENTIFIER,
+                sizeof(ETH_PERSONAL_SIGN_IDENTIFIER) - 1);
+  keccak_Update(&(ctx->msg_data_hash_ctx),
+                (const uint8_t *)size_string,
+                size_string_size);
+}
+
+void evm_update_msg_data_digest(evm_sign_msg_context_t *ctx,
+                                const uint8_t *data,
+                                uint32_t size) {
+  keccak_Update(&(ctx->msg_data_hash_ctx), data, size);
+}
+
 bool evm_get_msg_data_digest(const evm_sign_msg_context_t *ctx,
                              uint8_t *digest) {
   bool result = false;
@@ -209,8 +196,14 @@ bool evm_get_msg_data_digest(const evm_sign_msg_context_t *ctx,
   switch (ctx->init.message_type) {
     case EVM_SIGN_MSG_TYPE_ETH_SIGN:
     case EVM_SIGN_MSG_TYPE_PERSONAL_SIGN: {
-      result = evm_get_personal_data_digest(
-          ctx->msg_data, ctx->init.total_msg_size, digest);
+      if (0 == ctx->init.total_msg_size) {
+        break;
+      }
+      // Finalize a copy so that the context remains untouched
+      SHA3_CTX hash_ctx = ctx->msg_data_hash_ctx;
+      keccak_Final(&hash_ctx, digest);
+      memzero(&hash_ctx, sizeof(hash_ctx));
+      result = true;
     } break;
 
     case EVM_SIGN_MSG_TYPE_SIGN_TYPED_DATA: {
@@ -221,4 +214,4 @@ bool evm_get_msg_data_digest(const evm_sign_msg_context_t *ctx,
   }
 
   return result;
-}
\ No newline at end of file
+}
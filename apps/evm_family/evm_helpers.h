@@ -61,6 +61,28 @@
  */
 bool evm_derivation_path_guard(const uint32_t *path, uint32_t depth);
 
+/**
+ * @brief Starts the Keccak-256 digest of an ETH sign or personal sign message.
+ * @details Absorbs the "\x19Ethereum Signed Message:\n" prefix followed by the
+ * decimal message length taken from the initiate request, so that the message
+ * chunks can be hashed as they arrive.
+ *
+ * @param ctx A pointer to the signing context with a populated init member
+ */
+void evm_init_msg_data_digest(evm_sign_msg_context_t *ctx);
+
+/**
+ * @brief Absorbs a chunk of an ETH sign or personal sign message into the
+ * running digest.
+ *
+ * @param ctx A pointer to the signing context
+ * @param data The message chunk
+ * @param size The size of the message chunk in bytes
+ */
+void evm_update_msg_data_digest(evm_sign_msg_context_t *ctx,
+                                const uint8_t *data,
+                                uint32_t size);
+
 /**
  * @brief This function calculates the hash of the message data based on the
  * message type.
@@ -18,6 +18,7 @@
 #include "events.h"
 #include "evm_api.h"
 #include "evm_context.h"
+#include "sha3.h"
 
 /*****************************************************************************
  * MACROS AND DEFINES
@@ -26,10 +27,12 @@
 #define EVM_TRANSACTION_SIZE_CAP 20480
 
 /**
- * TODO: update the size of msg data same as EVM_TRANSACTION_SIZE_CAP.
+ * Size of the review window for ETH sign and personal sign messages.
  * Constraints : The LVGL buffer cannot handle more than 3Kb data size which
- * puts a limit on how much data can be displayed on the device. Possible fix is
- * to show the long messages in chunks in line with max LVGL buffer size.
+ * puts a limit on how much data can be displayed on the device at once. Such
+ * messages are hashed as their chunks arrive, so only the window is held in RAM
+ * and longer messages are reviewed one window at a time (up to
+ * EVM_TRANSACTION_SIZE_CAP bytes).
  */
 #define MAX_MSG_DATA_SIZE 3072
 
@@ -52,10 +55,18 @@ typedef struct evm_sign_msg_context {
   /// @brief  Contains initialization data for evm sign msg received from host
   evm_sign_msg_initiate_request_t init;
 
-  /// @brief  Pointer to msg data in raw format, size from init member is
-  /// allocated dynamically with a max size cap of @ref MAX_MSG_DATA_SIZE
+  /// @brief  Pointer to msg data in raw format. Typed data is held completely
+  /// (size from init member). For ETH sign and personal sign, it is the review
+  /// window of at most @ref MAX_MSG_DATA_SIZE bytes.
   uint8_t *msg_data;
 
+  /// @brief  Number of bytes currently held in the review window
+  uint32_t msg_data_size;
+
+  /// @brief  Running Keccak-256 state of the prefixed ETH sign or personal
+  /// sign message, updated as the chunks are received
+  SHA3_CTX msg_data_hash_ctx;
+
   evm_sign_typed_data_struct_t typed_data;
 } evm_sign_msg_context_t;
 
@@ -282,21 +282,15 @@ static bool get_public_key(const uint8_t *seed,
                            const uint32_t *path,
                            uint32_t path_length,
                            uint8_t *public_key) {
-  HDNode node = {0};
+  uint8_t buffer[EVM_PUB_KEY_SIZE] = {0};
+  uint8_t *out = (NULL != public_key) ? public_key : buffer;
 
-  if (!derive_hdnode_from_path(
-          path, path_length, SECP256K1_NAME, seed, &node)) {
+  if (!derive_public_key65_from_path(
+          path, path_length, SECP256K1_NAME, seed, out)) {
     // send unknown error; unknown failure reason
     evm_send_error(ERROR_COMMON_ERROR_UNKNOWN_ERROR_TAG, 1);
-    memzero(&node, sizeof(HDNode));
     return false;
   }
-
-  if (NULL != public_key) {
-    ecdsa_uncompress_pubkey(
-        get_curve_by_name(SECP256K1_NAME)->params, node.public_key, public_key);
-  }
-  memzero(&node, sizeof(HDNode));
   return true;
 }
 
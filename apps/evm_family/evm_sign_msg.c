@@ -64,6 +64,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "background_jobs.h"
 #include "evm_api.h"
 #include "evm_helpers.h"
 #include "evm_priv.h"
@@ -86,6 +87,15 @@
  * PRIVATE TYPEDEFS
  *****************************************************************************/
 
+/**
+ * Result of the background job computing the message digest while the user
+ * reviews the message
+ */
+typedef struct {
+  bool status;
+  uint8_t digest[32];
+} msg_digest_job_ctx_t;
+
 /*****************************************************************************
  * STATIC FUNCTION PROTOTYPES
  *****************************************************************************/
@@ -143,6 +153,38 @@ static bool handle_initiate_query(evm_query_t *query);
  */
 static bool get_msg_data(evm_query_t *query);
 
+/**
+ * @brief Returns true if the message is hashed as it is received, i.e. ETH sign
+ * and personal sign messages.
+ */
+static bool is_msg_data_streamed();
+
+/**
+ * @brief Returns the number of message bytes displayed per review window.
+ * @details ETH sign data is displayed as a hex string which takes twice the
+ * space of the raw data.
+ */
+static uint32_t get_msg_data_window_size();
+
+/**
+ * @brief Displays the message bytes collected in the review window for user
+ * verification and empties the window.
+ *
+ * @return a boolean indicating user verification or the rejection.
+ */
+static bool review_msg_data_window();
+
+/**
+ * @brief Computes the digest of the message in the background
+ * @details The EIP-712 struct hashing of typed data is recursive, hence it is
+ * done in a single step.
+ *
+ * @param arg Reference to the msg_digest_job_ctx_t instance
+ *
+ * @return bool Always true as the job completes in one step
+ */
+static bool msg_digest_job_step(void *arg);
+
 /**
  * @brief This function checks the message type and displays the message data
  * for verification.
@@ -181,6 +223,8 @@ static bool send_signature(evm_query_t *query,
  * STATIC VARIABLES
  *****************************************************************************/
 static evm_sign_msg_context_t sign_msg_ctx;
+static background_job_t msg_digest_job = {0};
+static msg_digest_job_ctx_t msg_digest_job_ctx = {0};
 
 /*****************************************************************************
  * GLOBAL VARIABLES
@@ -202,7 +246,7 @@ static bool check_which_request(const evm_query_t *query,
 }
 
 static bool validate_initiate_query(evm_sign_msg_initiate_request_t *init_req) {
-  uint32_t size_limit = MAX_MSG_DATA_SIZE;
+  uint32_t size_limit = EVM_TRANSACTION_SIZE_CAP;
 
   switch (init_req->message_type) {
     case EVM_SIGN_MSG_TYPE_SIGN_TYPED_DATA:
@@ -279,14 +323,22 @@ static bool get_msg_data(evm_query_t *query) {
   const common_chunk_payload_chunk_t *chunk = &(payload->chunk);
 
   uint32_t size = 0;
+  uint32_t buffer_size = total_size;
+
+  if (is_msg_data_streamed()) {
+    // Only a review window is held; the message is hashed as it arrives
+    buffer_size = CY_MIN(total_size, get_msg_data_window_size());
+    evm_init_msg_data_digest(&sign_msg_ctx);
+  }
 
   /**
-   * Allocate required memory for message size +1. Extra byte is used to add a
+   * Allocate required memory for buffer size +1. Extra byte is used to add a
    * NULL character at the end of the msg data in case it'll be used as a string
    */
-  sign_msg_ctx.msg_data = malloc(sign_msg_ctx.init.total_msg_size + 1);
+  sign_msg_ctx.msg_data = malloc(buffer_size + 1);
   ASSERT(NULL != sign_msg_ctx.msg_data);
-  sign_msg_ctx.msg_data[sign_msg_ctx.init.total_msg_size] = '\0';
+  sign_msg_ctx.msg_data[buffer_size] = '\0';
+  sign_msg_ctx.msg_data_size = 0;
 
   while (1) {
     // Get next data chunk from host
@@ -303,7 +355,30 @@ static bool get_msg_data(evm_query_t *query) {
       return false;
     }
 
-    memcpy(sign_msg_ctx.msg_data + size, chunk->bytes, chunk->size);
+    if (is_msg_data_streamed()) {
+      const uint8_t *bytes = chunk->bytes;
+      uint32_t remaining = chunk->size;
+
+      evm_update_msg_data_digest(&sign_msg_ctx, bytes, remaining);
+      while (0 < remaining) {
+        // A full window is reviewed only when more data follows it; the last
+        // window is reviewed in get_user_verification
+        if (buffer_size == sign_msg_ctx.msg_data_size &&
+            !review_msg_data_window()) {
+          return false;
+        }
+        uint32_t copy_size =
+            CY_MIN(remaining, buffer_size - sign_msg_ctx.msg_data_size);
+        memcpy(sign_msg_ctx.msg_data + sign_msg_ctx.msg_data_size,
+               bytes,
+               copy_size);
+        sign_msg_ctx.msg_data_size += copy_size;
+        bytes += copy_size;
+        remaining -= copy_size;
+      }
+    } else {
+      memcpy(sign_msg_ctx.msg_data + size, chunk->bytes, chunk->size);
+    }
     size += chunk->size;
 
     // Send chunk ack to host
@@ -343,20 +418,31 @@ static bool get_msg_data(evm_query_t *query) {
   return true;
 }
 
-static bool get_user_verification() {
+static bool is_msg_data_streamed() {
+  return EVM_SIGN_MSG_TYPE_ETH_SIGN == sign_msg_ctx.init.message_type ||
+         EVM_SIGN_MSG_TYPE_PERSONAL_SIGN == sign_msg_ctx.init.message_type;
+}
+
+static uint32_t get_msg_data_window_size() {
+  if (EVM_SIGN_MSG_TYPE_ETH_SIGN == sign_msg_ctx.init.message_type) {
+    return (MAX_MSG_DATA_SIZE - 3) / 2;
+  }
+  return MAX_MSG_DATA_SIZE;
+}
+
+static bool review_msg_data_window() {
   bool result = false;
   switch (sign_msg_ctx.init.message_type) {
     case EVM_SIGN_MSG_TYPE_ETH_SIGN: {
-      const size_t array_size = sign_msg_ctx.init.total_msg_size * 2 + 3;
+      const size_t array_size = sign_msg_ctx.msg_data_size * 2 + 3;
       char *buffer = malloc(array_size);
+      ASSERT(NULL != buffer);
       memzero(buffer, array_size);
       snprintf(buffer, array_size, "0x");
       byte_array_to_hex_string(sign_msg_ctx.msg_data,
-                               sign_msg_ctx.init.total_msg_size,
+                               sign_msg_ctx.msg_data_size,
                                buffer + 2,
                                array_size - 2);
-      // TODO: Add a limit on size of data per confirmation based on LVGL buffer
-      // and split message into multiple confirmations accordingly
       result = core_scroll_page(
           UI_TEXT_VERIFY_MESSAGE, (const char *)buffer, evm_send_error);
       memzero(buffer, array_size);
@@ -364,13 +450,40 @@ static bool get_user_verification() {
     } break;
 
     case EVM_SIGN_MSG_TYPE_PERSONAL_SIGN: {
-      // TODO: Add a limit on size of data per confirmation based on LVGL buffer
-      // and split message into multiple confirmations accordingly
+      sign_msg_ctx.msg_data[sign_msg_ctx.msg_data_size] = '\0';
       result = core_scroll_page(UI_TEXT_VERIFY_MESSAGE,
                                 (const char *)sign_msg_ctx.msg_data,
                                 evm_send_error);
     } break;
 
+    default:
+      break;
+  }
+
+  memzero(sign_msg_ctx.msg_data, sign_msg_ctx.msg_data_size);
+  sign_msg_ctx.msg_data_size = 0;
+  return result;
+}
+
+static bool msg_digest_job_step(void *arg) {
+  msg_digest_job_ctx_t *ctx = (msg_digest_job_ctx_t *)arg;
+  ctx->status = evm_get_msg_data_digest(&sign_msg_ctx, ctx->digest);
+  return true;
+}
+
+static bool get_user_verification() {
+  bool result = false;
+
+  // the digest is computed while the user goes through the screens
+  background_job_submit(
+      &msg_digest_job, msg_digest_job_step, &msg_digest_job_ctx);
+
+  switch (sign_msg_ctx.init.message_type) {
+    case EVM_SIGN_MSG_TYPE_ETH_SIGN:
+    case EVM_SIGN_MSG_TYPE_PERSONAL_SIGN: {
+      result = review_msg_data_window();
+    } break;
+
     case EVM_SIGN_MSG_TYPE_SIGN_TYPED_DATA: {
       ui_display_node *display_node = NULL;
       evm_init_typed_data_display_node(&display_node,
@@ -423,9 +536,15 @@ static bool get_msg_data_signature(evm_sign_msg_signature_response_t *sig) {
                    ERROR_DATA_FLOW_INVALID_DATA);
   } else {
     status = true;
-    if (!evm_get_msg_data_digest(&sign_msg_ctx, buffer) ||
-        (0 != ecdsa_sign_digest(
-                  curve, node.private_key, buffer, sig->r, sig->v, NULL))) {
+    // complete the digest if it is not computed yet
+    if (!background_job_finish(&msg_digest_job) ||
+        !msg_digest_job_ctx.status ||
+        (0 != ecdsa_sign_digest(curve,
+                                node.private_key,
+                                msg_digest_job_ctx.digest,
+                                sig->r,
+                                sig->v,
+                                NULL))) {
       evm_send_error(ERROR_COMMON_ERROR_UNKNOWN_ERROR_TAG, 1);
       status = false;
     }
@@ -465,13 +584,19 @@ void evm_sign_msg(evm_query_t *query) {
     delay_scr_init(ui_text_check_cysync_app, DELAY_TIME);
   }
 
+  background_job_cancel(&msg_digest_job);
   if (NULL != sign_msg_ctx.msg_data) {
-    memzero(sign_msg_ctx.msg_data, sign_msg_ctx.init.total_msg_size);
+    memzero(sign_msg_ctx.msg_data,
+            is_msg_data_streamed() ? sign_msg_ctx.msg_data_size
+                                   : sign_msg_ctx.init.total_msg_size);
     free(sign_msg_ctx.msg_data);
     sign_msg_ctx.msg_data = NULL;
   }
 
   sign_msg_ctx.init.total_msg_size = 0;
+  sign_msg_ctx.msg_data_size = 0;
+  memzero(&(sign_msg_ctx.msg_data_hash_ctx),
+          sizeof(sign_msg_ctx.msg_data_hash_ctx));
 
   /**
    * The tyepd data struct fields are of FT_POINTER type which means memory for
@@ -61,6 +61,7 @@
  *****************************************************************************/
 
 #include "address.h"
+#include "background_jobs.h"
 #include "evm_api.h"
 #include "evm_helpers.h"
 #include "evm_priv.h"
@@ -79,10 +80,23 @@
  * PRIVATE MACROS AND DEFINES
  *****************************************************************************/
 
+// Bytes of the transaction hashed by each step of the background job
+#define TXN_HASH_STEP_SIZE 1024
+
 /*****************************************************************************
  * PRIVATE TYPEDEFS
  *****************************************************************************/
 
+/**
+ * State of the background job computing the Keccak of the transaction while
+ * the user reviews it
+ */
+typedef struct {
+  SHA3_CTX hash_ctx;
+  uint32_t offset;
+  uint8_t digest[32];
+} txn_hash_job_ctx_t;
+
 /*****************************************************************************
  * STATIC FUNCTION PROTOTYPES
  *****************************************************************************/
@@ -156,6 +170,15 @@ STATIC bool handle_initiate_query(const evm_query_t *query);
  */
 STATIC bool fetch_valid_transaction(evm_query_t *query);
 
+/**
+ * @brief Hashes the next TXN_HASH_STEP_SIZE bytes of the transaction
+ *
+ * @param arg Reference to the txn_hash_job_ctx_t instance
+ *
+ * @return bool Indicating if the digest of the transaction is ready
+ */
+static bool txn_hash_job_step(void *arg);
+
 /**
  * @brief Aggregates user consent for the transaction info
  * @details The function decodes the receiver address along with the
@@ -204,6 +227,8 @@ static bool send_signature(evm_query_t *query,
  *****************************************************************************/
 
 STATIC evm_txn_context_t *txn_context = NULL;
+static background_job_t txn_hash_job = {0};
+static txn_hash_job_ctx_t txn_hash_job_ctx = {0};
 
 /*****************************************************************************
  * GLOBAL VARIABLES
@@ -339,8 +364,29 @@ STATIC bool fetch_valid_transaction(evm_query_t *query) {
   return status;
 }
 
+static bool txn_hash_job_step(void *arg) {
+  txn_hash_job_ctx_t *ctx = (txn_hash_job_ctx_t *)arg;
+  const uint32_t size = txn_context->init_info.transaction_size;
+  const uint32_t step_size = CY_MIN(TXN_HASH_STEP_SIZE, size - ctx->offset);
+
+  keccak_Update(
+      &ctx->hash_ctx, txn_context->transaction + ctx->offset, step_size);
+  ctx->offset += step_size;
+  if (ctx->offset < size) {
+    return false;
+  }
+  keccak_Final(&ctx->hash_ctx, ctx->digest);
+  return true;
+}
+
 STATIC bool get_user_verification() {
   bool status = false;
+
+  // the transaction is hashed while the user goes through the screens
+  keccak_256_Init(&txn_hash_job_ctx.hash_ctx);
+  txn_hash_job_ctx.offset = 0;
+  background_job_submit(&txn_hash_job, txn_hash_job_step, &txn_hash_job_ctx);
+
   switch (txn_context->txn_type) {
     case EVM_TXN_NO_DATA:
     case EVM_TXN_TOKEN_TRANSFER_FUNC:
@@ -392,12 +438,14 @@ static bool sign_transaction(evm_sign_txn_signature_response_t *sig) {
                    ERROR_DATA_FLOW_INVALID_DATA);
   } else {
     status = true;
-    keccak_256(txn_context->transaction,
-               txn_context->init_info.transaction_size,
-               buffer);
-
-    if (0 != ecdsa_sign_digest(
-                 curve, node.private_key, buffer, sig->r, sig->v, NULL)) {
+    // complete whatever part of the transaction hash is left
+    if (!background_job_finish(&txn_hash_job) ||
+        0 != ecdsa_sign_digest(curve,
+                               node.private_key,
+                               txn_hash_job_ctx.digest,
+                               sig->r,
+                               sig->v,
+                               NULL)) {
       evm_send_error(ERROR_COMMON_ERROR_UNKNOWN_ERROR_TAG, 1);
       status = false;
     }
@@ -437,6 +485,7 @@ void evm_sign_transaction(evm_query_t *query) {
     delay_scr_init(ui_text_check_cysync, DELAY_TIME);
   }
 
+  background_job_cancel(&txn_hash_job);
   if (NULL != txn_context->transaction) {
     free(txn_context->transaction);
   }
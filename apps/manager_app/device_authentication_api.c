@@ -76,6 +76,15 @@
 
 atecc_data_t atecc_data = {0};
 
+/// Precomputed multiples of the device auth public key, built on first use.
+/// It takes 4.6 KB of RAM (64 affine points); each verification against it
+/// saves the 252 doublings and 8 inversions of ecdsa_verify_digest, and every
+/// authentication flow verifies at least two signatures with this key.
+static ecdsa_pubkey_table auth_key_table;
+/// Public key the table was built for
+static uint8_t auth_key_table_key[ECDSA_PUB_KEY_SIZE] = {0};
+static bool auth_key_table_ready = false;
+
 #if (FIRMWARE_HASH_CALC == 0)
 static const uint8_t firmware_hash[] = {
     0x75, 0x36, 0x92, 0xec, 0x36, 0xad, 0xb4, 0xc7, 0x94, 0xc9, 0x73,
@@ -102,6 +111,15 @@ static void helper_get_gendig_hash(atecc_slot_define_t slot,
                                    uint8_t *digest,
                                    uint8_t *postfix);
 
+/**
+ * @brief Verifies a signature of the device auth key against the digest
+ * @details Uses the precomputed table of the auth public key, (re)building it
+ * when the public key in flash differs from the cached one.
+ *
+ * @return 0 if the verification succeeded, same codes as ecdsa_verify_digest
+ */
+static int verify_auth_signature(const uint8_t *sig, const uint8_t *digest);
+
 manager_auth_device_response_t __attribute__((optimize("O0")))
 sign_serial_number(void) {
   manager_auth_device_response_t response =
@@ -168,10 +186,8 @@ sign_serial_number(void) {
                              slot_2_auth_key,
                              slot_8_serial);
     {
-      uint8_t result = ecdsa_verify_digest(&nist256p1,
-                                           get_auth_public_key(),
-                                           response.serial_signature.signature,
-                                           sign_internal_param.digest);
+      uint8_t result = verify_auth_signature(
+          response.serial_signature.signature, sign_internal_param.digest);
       if (atecc_data.status != ATCA_SUCCESS || result != 0) {
         LOG_ERROR("err xxx32 fault %d verify %d", atecc_data.status, result);
         continue;
@@ -267,11 +283,8 @@ sign_random_challenge(uint8_t *challenge) {
     }
 
     {
-      uint8_t result =
-          ecdsa_verify_digest(&nist256p1,
-                              get_auth_public_key(),
-                              response.challenge_signature.signature,
-                              sign_internal_param.digest);
+      uint8_t result = verify_auth_signature(
+          response.challenge_signature.signature, sign_internal_param.digest);
       if (atecc_data.status != ATCA_SUCCESS || result != 0)
         LOG_ERROR("err xxx33 fault %d verify %d", atecc_data.status, result);
     }
@@ -297,7 +310,7 @@ void helper_get_gendig_hash(atecc_slot_define_t slot,
 
   uint8_t tempkey_init[96] = {0};
   uint8_t atecc_serial[9];
-  atecc_data.status = atcab_read_serial_number(atecc_serial);
+  atecc_data.status = atecc_get_serial_number(atecc_serial);
   memcpy(tempkey_init, data, 32);
   postfix[0] = tempkey_init[32] = 0x15;
   postfix[1] = tempkey_init[33] = 0x02;
@@ -323,11 +336,11 @@ ATCA_STATUS helper_sign_internal_msg(struct atca_sign_internal_in_out *param,
   temp_key.valid = 1;
   temp_key.source_flag = 1;
 
-  atecc_data.status = atcab_read_config_zone(cfg);
+  atecc_data.status = atecc_get_config_zone(cfg);
   memcpy(temp_key.value, param->message, 32);
   param->temp_key = &temp_key;
   helper_config_to_sign_internal(ATECC608A, param, cfg);
-  atecc_data.status = atcab_read_serial_number(sn);
+  atecc_data.status = atecc_get_serial_number(sn);
 
   if (param == NULL || param->temp_key == NULL) {
     return ATCA_BAD_PARAM;
@@ -425,4 +438,20 @@ ATCA_STATUS helper_config_to_sign_internal(
       (slot_locked & (1 << param->temp_key->key_id)) ? false : true;
 
   return ATCA_SUCCESS;
-}
\ No newline at end of file
+}
+
+static int verify_auth_signature(const uint8_t *sig, const uint8_t *digest) {
+  const uint8_t *auth_public_key = get_auth_public_key();
+
+  if (!auth_key_table_ready ||
+      0 != memcmp(auth_key_table_key, auth_public_key, ECDSA_PUB_KEY_SIZE)) {
+    auth_key_table_ready = false;
+    if (0 != ecdsa_pubkey_table_init(
+                 &nist256p1, auth_public_key, &auth_key_table)) {
+      return ecdsa_verify_digest(&nist256p1, auth_public_key, sig, digest);
+    }
+    memcpy(auth_key_table_key, auth_public_key, ECDSA_PUB_KEY_SIZE);
+    auth_key_table_ready = true;
+  }
+  return ecdsa_verify_digest_table(&nist256p1, &auth_key_table, sig, digest);
+}
@@ -335,23 +335,18 @@ static bool sign_txn(uint8_t *signature_buffer) {
              near_txn_context->unsigned_txn.txn.size,
              digest);
 
-  HDNode t_node = {0};
-  derive_hdnode_from_path(near_txn_context->init_info.derivation_path,
-                          near_txn_context->init_info.derivation_path_count,
-                          ED25519_NAME,
-                          seed,
-                          &t_node);
+  ed25519_expanded_key key = {0};
+  derive_ed25519_key_from_path(
+      near_txn_context->init_info.derivation_path,
+      near_txn_context->init_info.derivation_path_count,
+      seed,
+      &key);
 
-  ed25519_public_key public_key = {0};
-  ed25519_publickey(t_node.private_key, public_key);
-
-  ed25519_sign(
-      digest, sizeof(digest), t_node.private_key, public_key, signature_buffer);
+  ed25519_sign_expanded(digest, sizeof(digest), &key, signature_buffer);
 
   memzero(digest, sizeof(digest));
   memzero(seed, sizeof(seed));
-  memzero(&t_node, sizeof(t_node));
-  memzero(public_key, sizeof(public_key));
+  memzero(&key, sizeof(key));
 
   return true;
 }
@@ -410,7 +410,7 @@ STATIC bool fetch_seed(solana_query_t *query, uint8_t *seed_out) {
 static bool send_signature(solana_query_t *query,
                            uint8_t *seed,
                            solana_sign_txn_signature_response_t *sig) {
-  HDNode hdnode = {0};
+  ed25519_expanded_key key = {0};
   const size_t depth = solana_txn_context->init_info.derivation_path_count;
   const uint32_t *hd_path = solana_txn_context->init_info.derivation_path;
 
@@ -434,16 +434,15 @@ static bool send_signature(solana_query_t *query,
     return false;
 
   // sign updated transaction
-  if (!derive_hdnode_from_path(hd_path, depth, ED25519_NAME, seed, &hdnode))
+  if (!derive_ed25519_key_from_path(hd_path, depth, seed, &key))
     return false;
 
-  ed25519_sign(solana_txn_context->transaction,
-               solana_txn_context->init_info.transaction_size,
-               hdnode.private_key,
-               hdnode.public_key + 1,
-               sig->signature);
+  ed25519_sign_expanded(solana_txn_context->transaction,
+                        solana_txn_context->init_info.transaction_size,
+                        &key,
+                        sig->signature);
 
-  memzero(&hdnode, sizeof(hdnode));
+  memzero(&key, sizeof(key));
   memzero(seed, sizeof(seed));
 
   memcpy(&result.sign_txn.signature,
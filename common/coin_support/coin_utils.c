@@ -99,6 +99,51 @@ bool derive_hdnode_from_path(const uint32_t *path,
   return true;
 }
 
+bool derive_public_key65_from_path(const uint32_t *path,
+                                   const size_t path_length,
+                                   const char *curve,
+                                   const uint8_t *seed,
+                                   uint8_t *public_key) {
+  const curve_info *info = get_curve_by_name(curve);
+  HDNode hdnode = {0};
+
+  if (NULL == info || NULL == info->params) {
+    return false;
+  }
+
+  bool status = (0 != hdnode_from_seed(seed, 512 / 8, curve, &hdnode));
+  for (size_t i = 0; i < path_length && status; i++) {
+    // hdnode_private_ckd returns 1 when the derivation succeeds
+    status = (0 != hdnode_private_ckd(&hdnode, path[i]));
+  }
+  if (status) {
+    ecdsa_get_public_key65(info->params, hdnode.private_key, public_key);
+  }
+  memzero(&hdnode, sizeof(hdnode));
+  return status;
+}
+
+bool derive_ed25519_key_from_path(const uint32_t *path,
+                                  const size_t path_length,
+                                  const uint8_t *seed,
+                                  ed25519_expanded_key *key) {
+  HDNode hdnode = {0};
+  bool status = true;
+
+  hdnode_from_seed(seed, 512 / 8, ED25519_NAME, &hdnode);
+  for (size_t i = 0; i < path_length && status; i++) {
+    // hdnode_private_ckd returns 1 when the derivation succeeds
+    status = (0 != hdnode_private_ckd(&hdnode, path[i]));
+  }
+  if (status) {
+    // The public key of the node is skipped; it is computed along with the
+    // expansion of the secret key
+    ed25519_expand_key(hdnode.private_key, key);
+  }
+  memzero(&hdnode, sizeof(hdnode));
+  return status;
+}
+
 ui_display_node *ui_create_display_node(const char *title,
                                         const size_t title_size,
                                         const char *value,
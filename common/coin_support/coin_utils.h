@@ -23,6 +23,7 @@
 #include "bip39.h"
 #include "curves.h"
 #include "ecdsa.h"
+#include "ed25519-donna/ed25519.h"
 #include "logger.h"
 #include "ripemd160.h"
 #include "secp256k1.h"
@@ -288,6 +289,51 @@ bool derive_hdnode_from_path(const uint32_t *path,
                              const uint8_t *seed,
                              HDNode *hdnode);
 
+/**
+ * @brief Generates the uncompressed public key at the requested path
+ * @details The key is written straight from the point computed from the private
+ * key, unlike derive_hdnode_from_path() which keeps only the compressed form
+ * and needs a modular square root to recover the y coordinate again. Only
+ * ECDSA curves are supported.
+ *
+ * @param [in] path                 Path to derive the public key.
+ * @param [in] path_length          Length of the path.
+ * @param [in] curve                Curve name.
+ * @param [in] seed                 Seed to derive the public key of 64 bytes
+ * @param [out] public_key          Buffer of 65 bytes for the uncompressed
+ * public key (0x04 || x || y).
+ *
+ * @return bool Indicating if the derivation was successful
+ * @retval true If the public key derivation succeeded.
+ * @retval false If the derivation failed or the curve is not an ECDSA curve.
+ */
+bool derive_public_key65_from_path(const uint32_t *path,
+                                   size_t path_length,
+                                   const char *curve,
+                                   const uint8_t *seed,
+                                   uint8_t *public_key);
+
+/**
+ * @brief Derives the ed25519 signing key at the requested path
+ * @details The secret key is expanded and its public key computed once, so
+ * that any number of messages can be signed with ed25519_sign_expanded()
+ * without repeating either. The signatures are identical to the ones of
+ * ed25519_sign() with the node derived by derive_hdnode_from_path().
+ *
+ * @param [in] path                 Path to derive the key.
+ * @param [in] path_length          Length of the path.
+ * @param [in] seed                 Seed to derive the key of 64 bytes
+ * @param [out] key                 Expanded secret key and its public key
+ *
+ * @return bool Indicating if the derivation was successful
+ * @retval true If the key derivation succeeded.
+ * @retval false If the key derivation failed.
+ */
+bool derive_ed25519_key_from_path(const uint32_t *path,
+                                  size_t path_length,
+                                  const uint8_t *seed,
+                                  ed25519_expanded_key *key);
+
 void bech32_addr_encode(char *output,
                         char *hrp,
                         uint8_t *address_bytes,
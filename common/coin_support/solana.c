@@ -59,6 +59,8 @@
 
 #include "solana.h"
 
+#include "progress_api.h"
+
 size_t sol_get_derivation_depth(const uint16_t tag) {
   switch (tag) {
     case SOL_ACC_TYPE1:
@@ -72,7 +74,7 @@ size_t sol_get_derivation_depth(const uint16_t tag) {
   }
 }
 
-void solana_sig_unsigned_byte_array(const uint8_t *unsigned_txn_byte_array,
+bool solana_sig_unsigned_byte_array(const uint8_t *unsigned_txn_byte_array,
                                     uint64_t unsigned_txn_len,
                                     const txn_metadata *transaction_metadata,
                                     const char *mnemonics,
@@ -87,7 +89,11 @@ void solana_sig_unsigned_byte_array(const uint8_t *unsigned_txn_byte_array,
   size_t depth = sol_get_derivation_depth(transaction_metadata->address_tag);
   uint8_t seed[64] = {0};
   HDNode hdnode;
-  mnemonic_to_seed(mnemonics, passphrase, seed, NULL);
+  if (1 != mnemonic_to_seed_yield(
+               mnemonics, passphrase, seed, progress_api_yield)) {
+    memzero(seed, sizeof(seed));
+    return false;
+  }
   derive_hdnode_from_path(path, depth, ED25519_NAME, seed, &hdnode);
 
   ed25519_sign(unsigned_txn_byte_array,
@@ -98,6 +104,7 @@ void solana_sig_unsigned_byte_array(const uint8_t *unsigned_txn_byte_array,
   memzero(path, sizeof(path));
   memzero(seed, sizeof(seed));
   memzero(&hdnode, sizeof(hdnode));
+  return true;
 }
 
 int solana_update_blockhash_in_byte_array(uint8_t *byte_array,
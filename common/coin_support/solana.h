@@ -62,15 +62,16 @@ size_t sol_get_derivation_depth(uint16_t tag);
  * @param [out] sig                         Byte array of signature to store the
  * result of signing unsigned transaction byte array.
  *
- * @return
- * @retval
+ * @return bool Indicating if the transaction was signed
+ * @retval true The signature was written to sig
+ * @retval false The seed derivation was abandoned on a P0 event
  *
  * @see
  * @since v1.0.0
  *
  * @note
  */
-void solana_sig_unsigned_byte_array(const uint8_t *unsigned_txn_byte_array,
+bool solana_sig_unsigned_byte_array(const uint8_t *unsigned_txn_byte_array,
                                     uint64_t unsigned_txn_len,
                                     const txn_metadata *transaction_metadata,
                                     const char *mnemonics,
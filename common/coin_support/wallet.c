@@ -92,7 +92,7 @@ Wallet_credential_data CONFIDENTIAL wallet_credential_data = {
 
 /// Global instance to store shamir data
 Wallet_shamir_data CONFIDENTIAL wallet_shamir_data = {
-    {.arbitrary_data_shares = {{0}}},
+    {.mnemonic_shares = {{0}}},
     .share_x_coords = {0},
     .share_encryption_data = {{0}}};
 
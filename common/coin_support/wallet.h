@@ -16,6 +16,7 @@
 
 #include "memzero.h"
 #include "sha2.h"
+#include "shamir_wrapper.h"
 
 #define FAMILY_ID_SIZE 4
 #define CARD_ID_SIZE (FAMILY_ID_SIZE + 1)
@@ -37,6 +38,7 @@
 #define CHECKSUM_SIZE 4
 #define NAME_SIZE 16         ///< Size of name of wallet
 #define WALLET_ID_SIZE 32    ///< Size of wallet id (generated by hashing seed)
+#define WALLET_SEED_TAG_SIZE 32    ///< Size of the wallet entropy check value
 #define MAX_WALLETS_ALLOWED 4    ///< Maximum number of wallets allowed
 #define KEY_SIZE 32              // chacha polly key
 #define BENEFICIARY_KEY_SIZE 16
@@ -157,12 +159,19 @@ typedef struct Wallet {
 typedef struct Wallet_shamir_data {
   union {
     uint8_t mnemonic_shares[TOTAL_NUMBER_OF_SHARES][BLOCK_SIZE];
-    uint8_t arbitrary_data_shares[TOTAL_NUMBER_OF_SHARES]
-                                 [MAX_ARBITRARY_DATA_SIZE];
+    ///< SHA-256 of each card's arbitrary data share, taken when it is written
+    uint8_t arbitrary_data_share_digests[TOTAL_NUMBER_OF_SHARES]
+                                        [SHA256_DIGEST_LENGTH];
   };
   uint8_t share_x_coords[TOTAL_NUMBER_OF_SHARES];
   uint8_t share_encryption_data[TOTAL_NUMBER_OF_SHARES]
                                [PADDED_NONCE_SIZE + WALLET_MAC_SIZE];
+  ///< Split context of arbitrary data; each card's share is computed from it
+  ///< just before the card is written
+  shamir_stream_ctx_t arbitrary_data_stream;
+  ///< Cards whose read back arbitrary data share matched its digest, encoded
+  ///< as in Flash_Wallet.cards_states
+  uint8_t arbitrary_data_verified_cards;
 } Wallet_shamir_data;
 #pragma pack(pop)
 
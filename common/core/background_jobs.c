@@ -0,0 +1,186 @@
+/**
+ * @file    background_jobs.c
+ * @author  Cypherock X1 Team
+ * @brief   Cooperative scheduler of time sliced background computations
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "background_jobs.h"
+
+#include <stddef.h>
+
+#include "board.h"
+
+/*****************************************************************************
+ * EXTERN VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * PRIVATE TYPEDEFS
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC VARIABLES
+ *****************************************************************************/
+// Queued jobs in submission order; the head is the next job to be stepped
+static background_job_t *job_queue = NULL;
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ *****************************************************************************/
+/**
+ * @brief Unlinks the job from the queue if present
+ *
+ * @param job Job to be removed
+ */
+static void job_queue_remove(background_job_t *job);
+
+/**
+ * @brief Appends the job at the end of the queue
+ *
+ * @param job Job to be queued
+ */
+static void job_queue_append(background_job_t *job);
+
+/*****************************************************************************
+ * STATIC FUNCTIONS
+ *****************************************************************************/
+static void job_queue_remove(background_job_t *job) {
+  background_job_t **link = &job_queue;
+
+  while (NULL != *link) {
+    if (job == *link) {
+      *link = job->next;
+      job->next = NULL;
+      return;
+    }
+    link = &((*link)->next);
+  }
+}
+
+static void job_queue_append(background_job_t *job) {
+  background_job_t **link = &job_queue;
+
+  while (NULL != *link) {
+    link = &((*link)->next);
+  }
+  job->next = NULL;
+  *link = job;
+}
+
+/*****************************************************************************
+ * GLOBAL FUNCTIONS
+ *****************************************************************************/
+void background_job_submit(background_job_t *job,
+                           background_job_step_t step,
+                           void *arg) {
+  job_queue_remove(job);
+  job->step = step;
+  job->arg = arg;
+  job->done = false;
+  job_queue_append(job);
+}
+
+bool background_jobs_run(uint32_t budget_ms) {
+  const uint32_t start = uwTick;
+
+  if (NULL == job_queue) {
+    return false;
+  }
+
+  do {
+    background_job_t *job = job_queue;
+    job_queue_remove(job);
+    job->done = job->step(job->arg);
+    if (!job->done) {
+      // Rotate so that a long job does not starve the others
+      job_queue_append(job);
+    }
+  } while (NULL != job_queue && (uint32_t)(uwTick - start) < budget_ms);
+
+  return true;
+}
+
+bool background_jobs_pending(void) {
+  return NULL != job_queue;
+}
+
+bool background_job_finish(background_job_t *job) {
+  if (NULL == job->step) {
+    return false;
+  }
+
+  job_queue_remove(job);
+  while (!job->done) {
+    job->done = job->step(job->arg);
+  }
+  return true;
+}
+
+void background_job_cancel(background_job_t *job) {
+  job_queue_remove(job);
+  job->step = NULL;
+  job->done = false;
+}
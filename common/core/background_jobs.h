@@ -0,0 +1,102 @@
+/**
+ * @file    background_jobs.h
+ * @author  Cypherock X1 Team
+ * @brief   Cooperative scheduler of time sliced background computations
+ * @details While a flow waits for the user in get_events(), the MCU is mostly
+ * idle. Flows can submit the public-data computations they will need later
+ * (e.g. transaction digests) as background jobs. The event loop runs them one
+ * step at a time within its idle budget, and the flow collects the result
+ * with background_job_finish() which completes any remaining steps in the
+ * foreground.
+ *
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ * target=_blank>https://mitcc.org/</a>
+ *
+ */
+#ifndef BACKGROUND_JOBS_H
+#define BACKGROUND_JOBS_H
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * MACROS AND DEFINES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * TYPEDEFS
+ *****************************************************************************/
+/**
+ * Performs one bounded step of a job. A step must only compute; it must not
+ * wait for events or touch the display. Returns true once the job is complete.
+ */
+typedef bool (*background_job_step_t)(void *arg);
+
+/**
+ * The job is owned by the submitter and must stay valid until it is finished
+ * or cancelled.
+ */
+typedef struct background_job {
+  background_job_step_t step;
+  void *arg;
+  bool done;
+  struct background_job *next;
+} background_job_t;
+
+/*****************************************************************************
+ * EXPORTED VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ *****************************************************************************/
+/**
+ * @brief Queues a job to be run in the idle time of the event loop
+ *
+ * @param job Job instance owned by the caller
+ * @param step Step function of the job
+ * @param arg Opaque argument passed to each step
+ */
+void background_job_submit(background_job_t *job,
+                           background_job_step_t step,
+                           void *arg);
+
+/**
+ * @brief Runs steps of the queued jobs in round robin until the budget is
+ * spent or no job is left. At least one step is run if any job is queued.
+ *
+ * @param budget_ms Time available for the jobs
+ *
+ * @return true If any step was run
+ * @return false If there was no queued job
+ */
+bool background_jobs_run(uint32_t budget_ms);
+
+/**
+ * @brief Returns true if any submitted job is not complete yet
+ */
+bool background_jobs_pending(void);
+
+/**
+ * @brief Completes the job in the foreground and removes it from the queue
+ *
+ * @param job Job instance passed to background_job_submit()
+ *
+ * @return true If the job is complete
+ * @return false If the job was never submitted or was cancelled
+ */
+bool background_job_finish(background_job_t *job);
+
+/**
+ * @brief Removes the job from the queue without completing it. Calling it for
+ * a job which is not queued has no effect.
+ *
+ * @param job Job instance passed to background_job_submit()
+ */
+void background_job_cancel(background_job_t *job);
+
+#endif /* BACKGROUND_JOBS_H */
@@ -61,6 +61,12 @@
  *****************************************************************************/
 #include "events.h"
 
+#include "background_jobs.h"
+
+#if USE_SIMULATOR == 1
+#include "sim_usb_session.h"
+#endif
+
 /*****************************************************************************
  * EXTERN VARIABLES
  *****************************************************************************/
@@ -69,6 +75,10 @@
  * PRIVATE MACROS AND DEFINES
  *****************************************************************************/
 
+#define EVENT_LOOP_DELAY_MS 50
+// Interval at which host packets are serviced while the loop is waiting
+#define EVENT_USB_RX_POLL_MS 5
+
 /*****************************************************************************
  * PRIVATE TYPEDEFS
  *****************************************************************************/
@@ -100,8 +110,16 @@ evt_status_t get_events(uint8_t event_config, uint32_t timeout) {
   bool p0_evt_occurred = false;
   bool p1_evt_occurred = false;
 
+#if USE_SIMULATOR == 1
+  if (EVENT_CONFIG_UI == (event_config & EVENT_CONFIG_UI)) {
+    sim_session_ui_wait_begin();
+  }
+#endif
+
   /* Poll for the selected events, until atleast one event is captured. */
   while (1) {
+    // An abort from the host is raised while its packet is processed
+    usb_process_rx_packets();
     p0_evt_occurred = p0_get_evt(&(status.p0_event));
 
     /* As soon as a p0 event is registered, break the loop */
@@ -130,8 +148,16 @@ evt_status_t get_events(uint8_t event_config, uint32_t timeout) {
     }
 
     /* In each loop, provide 50ms delay for things to stabilize, for example USB
-     * interrupts, OLED display, etc */
-    BSP_DelayMs(50);
+     * interrupts, OLED display, etc. Host packets keep being serviced during
+     * the delay so that each chunk is acknowledged without waiting a full
+     * loop. The delay is spent on pending background jobs, if any. */
+    for (uint32_t elapsed = 0; elapsed < EVENT_LOOP_DELAY_MS;
+         elapsed += EVENT_USB_RX_POLL_MS) {
+      if (!background_jobs_run(EVENT_USB_RX_POLL_MS)) {
+        BSP_DelayMs(EVENT_USB_RX_POLL_MS);
+      }
+      usb_process_rx_packets();
+    }
 
     /* As soon as an event is registered, break the loop */
     if (p1_evt_occurred) {
@@ -139,6 +165,12 @@ evt_status_t get_events(uint8_t event_config, uint32_t timeout) {
     }
   }
 
+#if USE_SIMULATOR == 1
+  if (EVENT_CONFIG_UI == (event_config & EVENT_CONFIG_UI)) {
+    sim_session_ui_wait_end();
+  }
+#endif
+
   /* Any post cleanup required */
   p0_ctx_destroy();
 
@@ -0,0 +1,174 @@
+/**
+ * @file    progress_api.c
+ * @author  Cypherock X1 Team
+ * @brief   Cooperative progress reporting for long running computations
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "progress_api.h"
+
+#include <stdio.h>
+
+#include "memzero.h"
+#include "p0_events.h"
+#include "usb_api.h"
+#include "ui_instruction.h"
+
+/*****************************************************************************
+ * EXTERN VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ *****************************************************************************/
+#define PROGRESS_TEXT_SIZE 64
+
+/*****************************************************************************
+ * PRIVATE TYPEDEFS
+ *****************************************************************************/
+typedef struct {
+  bool active;
+  bool aborted;
+  const char *message;
+  uint32_t last_refresh_tick;
+  uint8_t last_percent;
+  char text[PROGRESS_TEXT_SIZE];
+} progress_ctx_t;
+
+/*****************************************************************************
+ * STATIC VARIABLES
+ *****************************************************************************/
+static progress_ctx_t progress_ctx;
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ *****************************************************************************/
+/**
+ * @brief Renders the completion percentage below the progress message
+ *
+ * @param percent Completion percentage to be shown
+ */
+static void progress_render(uint8_t percent);
+
+/*****************************************************************************
+ * STATIC FUNCTIONS
+ *****************************************************************************/
+static void progress_render(uint8_t percent) {
+  snprintf(progress_ctx.text,
+           sizeof(progress_ctx.text),
+           "%s\n%d%%",
+           progress_ctx.message,
+           percent);
+  instruction_scr_change_text(progress_ctx.text, true);
+  progress_ctx.last_percent = percent;
+  progress_ctx.last_refresh_tick = uwTick;
+}
+
+/*****************************************************************************
+ * GLOBAL FUNCTIONS
+ *****************************************************************************/
+void progress_api_start(const char *message) {
+  memzero(&progress_ctx, sizeof(progress_ctx));
+  progress_ctx.message = message;
+  progress_ctx.active = true;
+
+  instruction_scr_init(message, NULL);
+  progress_render(0);
+}
+
+bool progress_api_yield(uint32_t current, uint32_t total) {
+  p0_evt_t p0_evt = {0};
+
+  if (progress_ctx.active && progress_ctx.aborted) {
+    return false;
+  }
+
+  // Service host packets; a status request is answered and an abort raises the
+  // p0 event checked below
+  usb_process_rx_packets();
+  if (p0_get_evt(&p0_evt)) {
+    // Only a started context remembers the abort; a computation without one
+    // must not be cut by an event the flow has since handled
+    progress_ctx.aborted = progress_ctx.active;
+    return false;
+  }
+
+  if (!progress_ctx.active || 0 == total) {
+    return true;
+  }
+
+  uint8_t percent = (uint8_t)(((uint64_t)current * 100) / total);
+  if (percent != progress_ctx.last_percent &&
+      (uwTick - progress_ctx.last_refresh_tick) >= PROGRESS_UI_REFRESH_MS) {
+    progress_render(percent);
+  }
+
+  return true;
+}
+
+bool progress_api_is_aborted(void) {
+  return progress_ctx.aborted;
+}
+
+void progress_api_stop(void) {
+  progress_ctx.active = false;
+  progress_ctx.message = NULL;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file    progress_api.h
+ * @author  Cypherock X1 Team
+ * @brief   Cooperative progress reporting for long running computations
+ * @details Computations like the BIP39 seed derivation run for a few seconds
+ * without returning to the event loop. They periodically call
+ * progress_api_yield() which refreshes the progress shown on the display and
+ * reports whether a P0 event (host abort or inactivity) occurred meanwhile, so
+ * that the computation can be abandoned early.
+ *
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ * target=_blank>https://mitcc.org/</a>
+ *
+ */
+#ifndef PROGRESS_API_H
+#define PROGRESS_API_H
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * MACROS AND DEFINES
+ *****************************************************************************/
+// Minimum interval between two refreshes of the progress on the display
+#define PROGRESS_UI_REFRESH_MS 100
+
+/*****************************************************************************
+ * TYPEDEFS
+ *****************************************************************************/
+
+/*****************************************************************************
+ * EXPORTED VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ *****************************************************************************/
+/**
+ * @brief Starts reporting the progress of a long running computation. The
+ * message is rendered on an instruction screen along with the completion
+ * percentage.
+ *
+ * @param message Message to be shown while the computation runs
+ */
+void progress_api_start(const char *message);
+
+/**
+ * @brief Yield point of a long running computation. Updates the progress on
+ * the display (rate limited to PROGRESS_UI_REFRESH_MS) and checks for P0
+ * events. The P0 event is left pending so that the flow handles it as usual.
+ * If no progress context is started, the API only checks for P0 events.
+ *
+ * @param current Amount of work completed
+ * @param total Total amount of work
+ *
+ * @return true If the computation can continue
+ * @return false If a P0 event occurred and the computation must be abandoned
+ */
+bool progress_api_yield(uint32_t current, uint32_t total);
+
+/**
+ * @brief Returns true if progress_api_yield() requested the computation to be
+ * abandoned since the last call to progress_api_start()
+ */
+bool progress_api_is_aborted(void);
+
+/**
+ * @brief Stops reporting the progress. The screen is left as is for the next
+ * UI component to replace it.
+ */
+void progress_api_stop(void);
+
+#endif /* PROGRESS_API_H */
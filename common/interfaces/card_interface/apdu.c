@@ -67,6 +67,7 @@
  * Wallet Share is Wallet_Share + Chacha Polly Mac + Nonce
  */
 static Card_Data_Health card_data_health = DATA_HEALTH_UNKNOWN;
+static card_capabilities_t card_capabilities;
 static uint8_t session_enc_key[32];
 static uint8_t session_mac_key[32];
 static uint8_t session_iv[16];
@@ -290,6 +291,31 @@ uint16_t create_apdu_retrieve_wallet(const struct Wallet *wallet,
   return index;
 }
 
+uint16_t create_apdu_retrieve_wallet_fields(const struct Wallet *wallet,
+                                            const uint16_t field_mask,
+                                            uint8_t apdu[]) {
+  ASSERT(apdu != NULL);
+  ASSERT(wallet != NULL);
+
+  apdu[OFFSET_CLA] = CLA_ISO7816;
+  apdu[OFFSET_INS] = APDU_RETRIEVE_WALLET;
+  apdu[OFFSET_P1] = P1_RETRIEVE_WALLET_SELECTED;
+  apdu[OFFSET_P2] = 0x00;
+
+  uint16_t index = 5;
+
+  fill_tlv(apdu, &index, INS_NAME, NAME_SIZE, wallet);
+  fill_tlv(apdu, &index, INS_PASSWORD, BLOCK_SIZE, wallet);
+  apdu[index++] = TAG_FIELD_MASK;
+  apdu[index++] = WALLET_FIELD_MASK_SIZE;
+  apdu[index++] = field_mask >> 8;
+  apdu[index++] = field_mask & 0xFF;
+
+  apdu[OFFSET_LC] = index - 5;
+
+  return index;
+}
+
 uint16_t create_apdu_delete_wallet(const struct Wallet *wallet,
                                    uint8_t apdu[]) {
   ASSERT(apdu != NULL);
@@ -481,17 +507,25 @@ void extract_apdu_get_challenge(uint8_t target[SHA256_SIZE],
   }
 }
 
-void extract_from_apdu(struct Wallet *wallet,
-                       const uint8_t apdu[],
-                       const uint16_t len) {
+uint16_t extract_from_apdu(struct Wallet *wallet,
+                           const uint8_t apdu[],
+                           const uint16_t len) {
   ASSERT(wallet != NULL);
   ASSERT(apdu != NULL);
   ASSERT(len != 0);
 
-  uint16_t index = 0;
+  uint16_t index = 0, fields = 0;
 
   while (index < len) {
-    switch (apdu[index++]) {
+    uint8_t tag = apdu[index++];
+
+    if (tag >= INS_NAME && tag <= INS_WALLET_ID) {
+      fields |= WALLET_FIELD(tag);
+    } else if (tag == INS_ARBITRARY_DATA) {
+      fields |= WALLET_FIELD_ARBITRARY_DATA;
+    }
+
+    switch (tag) {
       case INS_NAME:
         memcpy(wallet->wallet_name, apdu + index + 1, apdu[index]);
         index += (apdu[index] + 1);
@@ -555,6 +589,8 @@ void extract_from_apdu(struct Wallet *wallet,
         break;
     }
   }
+
+  return fields;
 }
 
 ISO7816 extract_card_detail_from_apdu(const uint8_t apdu[],
@@ -575,6 +611,7 @@ ISO7816 extract_card_detail_from_apdu(const uint8_t apdu[],
 
   uint16_t index = 0;
 
+  memzero(&card_capabilities, sizeof(card_capabilities));
   while (index < len) {
     switch (apdu[index++]) {
       case TAG_VERSION:
@@ -601,6 +638,13 @@ ISO7816 extract_card_detail_from_apdu(const uint8_t apdu[],
         if (recovery_mode)
           *recovery_mode = apdu[++index];
         break;
+      case TAG_CARD_CAPABILITIES:
+        if (apdu[index] >= sizeof(card_capabilities)) {
+          card_capabilities.flags = apdu[index + 1];
+          card_capabilities.max_frame_len = apdu[index + 2];
+        }
+        index += (apdu[index] + 1);
+        break;
       default:
         break;
     }
@@ -658,10 +702,13 @@ int apdu_encrypt_data(uint8_t *InOut_data, uint16_t *data_len) {
   return 0;
 }
 
-int apdu_decrypt_data(uint8_t *InOut_data, uint8_t *len) {
+int apdu_decrypt_data(uint8_t *InOut_data, uint16_t *len) {
   ASSERT(InOut_data != NULL);
   ASSERT(len != NULL);
 
+  if (*len < 16 + 2 + 16)
+    return NFC_SC_MAC_MISMATCH;
+
   uint16_t data_len = *len - 16 - 2;
   uint8_t payload[data_len], iv[16] = {0};
   aes_decrypt_ctx dec_ctx = {0};
@@ -720,6 +767,10 @@ void reset_card_data_health() {
   card_data_health = DATA_HEALTH_UNKNOWN;
 }
 
+const card_capabilities_t *get_card_capabilities() {
+  return &card_capabilities;
+}
+
 void apdu_extract_wallet_list(wallet_list_t *list,
                               uint8_t *apdu,
                               uint16_t len) {
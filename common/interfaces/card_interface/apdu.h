@@ -33,6 +33,20 @@
 #define POW_RAND_NUMBER_SIZE 32
 #define POW_NONCE_SIZE 32
 
+/// Bit of the retrieve wallet field mask selecting a wallet structure tag
+#define WALLET_FIELD(tag) ((uint16_t)1 << ((tag)-INS_NAME))
+#define WALLET_FIELD_ARBITRARY_DATA ((uint16_t)1 << 15)
+#define WALLET_FIELD_MASK_SIZE 2
+
+/// Fields needed to reconstruct a wallet from its shares, along with the ones
+/// covered by the structure checksum; the name is part of the request
+#define WALLET_FIELDS_FOR_SHARE                                                \
+  (WALLET_FIELD(INS_xCor) | WALLET_FIELD(INS_NO_OF_MNEMONICS) |                \
+   WALLET_FIELD(INS_TOTAL_NO_OF_SHARE) | WALLET_FIELD(INS_WALLET_SHARE) |      \
+   WALLET_FIELD(INS_STRUCTURE_CHECKSUM) | WALLET_FIELD(INS_MIN_NO_OF_SHARES) | \
+   WALLET_FIELD(INS_WALLET_INFO) | WALLET_FIELD(INS_KEY) |                     \
+   WALLET_FIELD(INS_WALLET_ID) | WALLET_FIELD_ARBITRARY_DATA)
+
 /// ISO7816 values
 #define CLA_ISO7816 0x00
 #define INS_EXTERNAL_AUTHENTICATE 0x82
@@ -45,6 +59,14 @@
 #define OFFSET_P1 0x02
 #define OFFSET_P2 0x03
 
+/// CLA bit set on every fragment of a command protected as a whole message
+#define CLA_WHOLE_MSG_SC 0x04
+
+/// Card capability: secure channel MAC and padding cover the whole message
+#define CARD_CAP_WHOLE_MSG_SC 0x01
+/// Card capability: retrieve wallet serves the fields selected by a field mask
+#define CARD_CAP_SELECTIVE_RETRIEVE 0x02
+
 /* TODO: Remove ISO7816 macro as it actually corresponds to card status*/
 #define ISO7816 card_error_status_word_e
 
@@ -55,6 +77,12 @@ typedef enum {
   DATA_HEALTH_CORRUPT = 0xFF,
 } Card_Data_Health;
 
+/// Optional features advertised by the card applet in the select response
+typedef struct {
+  uint8_t flags;            ///< CARD_CAP_* bits
+  uint8_t max_frame_len;    ///< Largest C-APDU data per frame, 0 if unknown
+} card_capabilities_t;
+
 /// enum defined with expected lengths for different APDUs
 typedef enum {
   PAIRING_EXPECTED_MIN_LENGTH = 52,    ///< Minimum length of pairing APDU
@@ -93,6 +121,9 @@ typedef enum {
 
   P1_INHERITANCE_DECRYPT_DATA = 0x00,
   P1_INHERITANCE_ENCRYPT_DATA = 0x01,
+
+  P1_RETRIEVE_WALLET_ALL = 0x00,
+  P1_RETRIEVE_WALLET_SELECTED = 0x01,
 } p1_function_subfunction;
 
 /// enum for tag values in APDUs
@@ -121,6 +152,7 @@ typedef enum {
   TAG_CARD_KEYID,
   TAG_CARD_IV,
   TAG_RECOVERY_MODE,
+  TAG_CARD_CAPABILITIES,
 
   TAG_SIGNED_DATA = 0xEB,
 
@@ -134,6 +166,9 @@ typedef enum {
   TAG_INHERITANCE_PLAIN_DATA = 0xD5,
   TAG_INHERITANCE_ENCRYPTED_DATA = 0xD6,
   TAG_DATA_DISCREPANCY = 0xD7,
+
+  // Tag for retrieve wallet
+  TAG_FIELD_MASK = 0xD8,
 } Tag_value;
 
 /**
@@ -237,6 +272,21 @@ uint16_t create_apdu_add_arbitrary_data(const struct Wallet *wallet,
 uint16_t create_apdu_retrieve_wallet(const struct Wallet *wallet,
                                      uint8_t apdu[]);
 
+/**
+ * @brief Create a apdu for retrieve wallet returning only the selected fields.
+ * @details Only understood by cards advertising
+ * CARD_CAP_SELECTIVE_RETRIEVE.
+ *
+ * @param wallet      Pointer to Wallet instance.
+ * @param field_mask  Fields to retrieve, built with WALLET_FIELD().
+ * @param apdu        Byte array to store apdu.
+ *
+ * @return Length of stored bytes.
+ */
+uint16_t create_apdu_retrieve_wallet_fields(const struct Wallet *wallet,
+                                            uint16_t field_mask,
+                                            uint8_t apdu[]);
+
 /**
  * @brief Create a apdu for delete wallet.
  * @details
@@ -409,7 +459,7 @@ void extract_apdu_get_challenge(uint8_t target[SHA256_SIZE],
  * @param[in]  apdu Received APDU
  * @param[in]  len Length of received APDU
  *
- * @return
+ * @return Mask of the fields found in the APDU, see WALLET_FIELD()
  * @retval
  *
  * @see
@@ -417,9 +467,9 @@ void extract_apdu_get_challenge(uint8_t target[SHA256_SIZE],
  *
  * @note
  */
-void extract_from_apdu(struct Wallet *wallet,
-                       const uint8_t apdu[],
-                       uint16_t len);
+uint16_t extract_from_apdu(struct Wallet *wallet,
+                           const uint8_t apdu[],
+                           uint16_t len);
 
 /**
  * @brief Deserialize family-id and applet version of the card
@@ -495,7 +545,7 @@ int apdu_encrypt_data(uint8_t *InOut_data, uint16_t *len);
  *
  * @note
  */
-int apdu_decrypt_data(uint8_t *InOut_data, uint8_t *len);
+int apdu_decrypt_data(uint8_t *InOut_data, uint16_t *len);
 
 /**
  * @brief Extract the card data health status from the response apdu.
@@ -541,6 +591,15 @@ Card_Data_Health get_card_data_health();
  */
 void reset_card_data_health();
 
+/**
+ * @brief Gets the capabilities of the card selected last.
+ * @details Filled by extract_card_detail_from_apdu(); cards that do not
+ * advertise TAG_CARD_CAPABILITIES report no capability.
+ *
+ * @return const card_capabilities_t* Capabilities of the card
+ */
+const card_capabilities_t *get_card_capabilities();
+
 /**
  * @brief Deserialize raw APDU for wallet list command from an X1 card
  *
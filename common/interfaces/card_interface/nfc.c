@@ -64,17 +64,34 @@
 #include "application_startup.h"
 #include "assert_conf.h"
 #include "sys_state.h"
+#include "usb_api.h"
 #include "utils.h"
 #include "wallet_utilities.h"
 
+// Logs on every failed exchange; can be trimmed independently of LOG_LEVEL
+#ifndef NFC_LOG_LEVEL
+#define NFC_LOG_LEVEL LOG_LEVEL
+#endif
+#undef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL NFC_LOG_LEVEL
+
 #define SEND_PACKET_MAX_LEN 236
 #define RECV_PACKET_MAX_ENC_LEN 242
 #define RECV_PACKET_MAX_LEN 225
+// Largest C-APDU data per InDataExchange; the PN532 handles the ISO 14443-4
+// block chaining below it with the FSD/FSC agreed during activation. The
+// 256 byte packet buffer of the PN532 driver also holds the frame overhead,
+// the InDataExchange command, the target number and the APDU header.
+#define NFC_FRAME_MAX_LEN 240
 
 static void (*early_exit_handler)() = NULL;
 static uint8_t nfc_device_key_id[4];
 static bool nfc_secure_comm = true;
 static uint8_t request_chain_pkt[] = {0x00, 0xCF, 0x00, 0x00};
+// Negotiated with the card on applet select
+static uint8_t nfc_frame_len = SEND_PACKET_MAX_LEN;
+static bool nfc_whole_msg_sc = false;
+static bool nfc_selective_retrieve = false;
 
 /**
  * @brief Check if any error is received from NFC.
@@ -126,6 +143,7 @@ void nfc_detect_card_removal() {
   uint32_t err = 0;
   uint8_t err_count = 0;
   do {
+    usb_process_rx_packets();
     err = adafruit_diagnose_card_presence();
     if (err != 0) {
       err_count++;
@@ -150,6 +168,9 @@ ret_code_t nfc_select_card() {
     reset_inactivity_timer();
     err_code =
         adafruit_pn532_nfc_a_target_init(&tag_info, DEFAULT_NFC_TG_INIT_TIME);
+    // Host packets are only parsed in thread context; an abort sets the reset
+    // flow flag checked here and status requests get answered while waiting
+    usb_process_rx_packets();
     if (CY_Read_Reset_Flow() && early_exit_handler) {
       (*early_exit_handler)();
       return STM_ERROR_NULL;
@@ -172,8 +193,21 @@ void nfc_deselect_card() {
 
 ret_code_t nfc_wait_for_card(const uint16_t wait_time) {
   nfc_a_tag_info tag_info;
+  ret_code_t err_code = STM_SUCCESS;
   sys_flow_cntrl_u.bits.nfc_off = false;
-  return adafruit_pn532_nfc_a_target_init(&tag_info, wait_time);
+  err_code = adafruit_pn532_nfc_a_target_init(&tag_info, wait_time);
+  usb_process_rx_packets();
+  return err_code;
+}
+
+static void nfc_negotiate_capabilities(const card_capabilities_t *caps) {
+  nfc_whole_msg_sc = (caps->flags & CARD_CAP_WHOLE_MSG_SC) != 0;
+  nfc_selective_retrieve = (caps->flags & CARD_CAP_SELECTIVE_RETRIEVE) != 0;
+  if (caps->max_frame_len > SEND_PACKET_MAX_LEN) {
+    nfc_frame_len = caps->max_frame_len < NFC_FRAME_MAX_LEN
+                        ? caps->max_frame_len
+                        : NFC_FRAME_MAX_LEN;
+  }
 }
 
 ISO7816 nfc_select_applet(uint8_t expected_family_id[],
@@ -187,9 +221,12 @@ ISO7816 nfc_select_applet(uint8_t expected_family_id[],
   ISO7816 status_word;
   uint8_t send_apdu[255], recv_apdu[255] = {0},
                           _version[CARD_VERSION_SIZE] = {0};
-  uint16_t send_len = 5, recv_len = 236;
+  uint16_t send_len = 5, recv_len = sizeof(recv_apdu);
 
   send_len = create_apdu_select_applet(send_apdu);
+  nfc_frame_len = SEND_PACKET_MAX_LEN;
+  nfc_whole_msg_sc = false;
+  nfc_selective_retrieve = false;
 
   nfc_secure_comm = false;
   uint32_t system_clock = uwTick;
@@ -215,6 +252,7 @@ ISO7816 nfc_select_applet(uint8_t expected_family_id[],
       bool first_time = true;
       if (_version[0] == 0x01)
         return SW_INCOMPATIBLE_APPLET;
+      nfc_negotiate_capabilities(get_card_capabilities());
       if (version)
         memcpy(version, _version, CARD_VERSION_SIZE);
 
@@ -255,7 +293,7 @@ ISO7816 nfc_pair(uint8_t *data_inOut, uint8_t *length_inOut) {
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[255], recv_apdu[255] = {0};
-  uint16_t send_len = 5, recv_len = 236;
+  uint16_t send_len = 5, recv_len = sizeof(recv_apdu);
 
   send_len = create_apdu_pair(data_inOut, *length_inOut, send_apdu);
 
@@ -286,7 +324,7 @@ ISO7816 nfc_pair(uint8_t *data_inOut, uint8_t *length_inOut) {
 ISO7816 nfc_unpair() {
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[255], recv_apdu[255] = {0};
-  uint16_t send_len = 5, recv_len = 236;
+  uint16_t send_len = 5, recv_len = sizeof(recv_apdu);
 
   hex_string_to_byte_array("00130000", 8, send_apdu);
   nfc_secure_comm = true;
@@ -312,8 +350,8 @@ ISO7816 nfc_list_all_wallet(wallet_list_t *wallet_list) {
   uint8_t *recv_apdu = send_apdu;
 
   // recv_len receives the length of response APDU. It also
-  // acts as expected length of response APDU.
-  uint16_t recv_len = 236;
+  // acts as the capacity of the buffer for the response APDU.
+  uint16_t recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_list_wallet(send_apdu);
 
@@ -343,7 +381,7 @@ ISO7816 nfc_add_wallet(const struct Wallet *wallet) {
   // Call nfc_select_card() before
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   calculate_checksum(wallet, (uint8_t *)wallet->checksum);
   if (WALLET_IS_ARBITRARY_DATA(wallet->wallet_info))
@@ -375,10 +413,8 @@ ISO7816 nfc_retrieve_wallet(struct Wallet *wallet) {
   // Call nfc_select_card() before
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = RETRIEVE_WALLET_EXPECTED_LENGTH + 32;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
-  if (WALLET_IS_ARBITRARY_DATA(wallet->wallet_info))
-    recv_len = 244;
   send_len = create_apdu_retrieve_wallet(wallet, send_apdu);
 
   nfc_secure_comm = true;
@@ -408,12 +444,72 @@ ISO7816 nfc_retrieve_wallet(struct Wallet *wallet) {
   return status_word;
 }
 
+/**
+ * Checks that the card returned every requested field. A structure checksum
+ * marked unusable passes verify_checksum(), so missing fields are not left to
+ * it.
+ */
+static bool has_wallet_fields(const struct Wallet *wallet,
+                              uint16_t field_mask,
+                              uint16_t fields) {
+  if (WALLET_IS_ARBITRARY_DATA(wallet->wallet_info)) {
+    field_mask &= ~WALLET_FIELD(INS_WALLET_SHARE);
+  } else {
+    field_mask &= ~WALLET_FIELD_ARBITRARY_DATA;
+  }
+
+  return (fields & field_mask) == field_mask;
+}
+
+ISO7816 nfc_retrieve_wallet_fields(struct Wallet *wallet, uint16_t field_mask) {
+  ASSERT(wallet != NULL);
+
+  if (!nfc_selective_retrieve)
+    return nfc_retrieve_wallet(wallet);
+
+  // Call nfc_select_card() before
+  ISO7816 status_word = CLA_ISO7816;
+  uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
+
+  send_len = create_apdu_retrieve_wallet_fields(wallet, field_mask, send_apdu);
+
+  nfc_secure_comm = true;
+  uint32_t system_clock = uwTick;
+  ret_code_t err_code =
+      nfc_exchange_apdu(send_apdu, send_len, recv_apdu, &recv_len);
+  LOG_SWV("Retrieve wallet fields in %lums\n", uwTick - system_clock);
+
+  if (err_code != STM_SUCCESS) {
+    return err_code;
+  } else {
+    status_word = (recv_apdu[recv_len - 2] * 256);
+    status_word += recv_apdu[recv_len - 1];
+
+    if (status_word == SW_NO_ERROR) {
+      uint16_t fields = extract_from_apdu(wallet, recv_apdu, recv_len);
+      Card_Data_errors_t status = validate_wallet(wallet);
+      if (!has_wallet_fields(wallet, field_mask, fields) ||
+          status != VALID_DATA) {
+        LOG_CRITICAL("edat %04x %d", fields, status);
+        status_word = 0;
+      }
+    }
+  }
+
+  memzero(recv_apdu, sizeof(send_apdu));
+  // The card advertised the capability but does not know the field mask
+  if (status_word == SW_INCORRECT_P1P2 || status_word == SW_WRONG_P1P2)
+    return nfc_retrieve_wallet(wallet);
+  return status_word;
+}
+
 ISO7816 nfc_delete_wallet(const struct Wallet *wallet) {
   ASSERT(wallet != NULL);
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_delete_wallet(wallet, send_apdu);
 
@@ -442,7 +538,7 @@ ISO7816 nfc_ecdsa(uint8_t data_inOut[ECDSA_SIGNATURE_SIZE],
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_ecdsa(data_inOut, *length_inOut, send_apdu);
 
@@ -483,7 +579,7 @@ ISO7816 nfc_verify_challenge(const uint8_t name[NAME_SIZE],
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_verify_challenge(name, nonce, password, send_apdu);
 
@@ -513,7 +609,7 @@ ISO7816 nfc_get_challenge(const uint8_t name[NAME_SIZE],
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_get_challenge(name, send_apdu);
 
@@ -550,7 +646,7 @@ ISO7816 nfc_encrypt_data(const uint8_t name[NAME_SIZE],
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_inheritance(name,
                                      plain_data,
@@ -593,7 +689,7 @@ ISO7816 nfc_decrypt_data(const uint8_t name[NAME_SIZE],
 
   ISO7816 status_word = CLA_ISO7816;
   uint8_t send_apdu[600] = {0}, *recv_apdu = send_apdu;
-  uint16_t send_len = 0, recv_len = 236;
+  uint16_t send_len = 0, recv_len = sizeof(send_apdu);
 
   send_len = create_apdu_inheritance(name,
                                      encrypted_data,
@@ -623,6 +719,80 @@ ISO7816 nfc_decrypt_data(const uint8_t name[NAME_SIZE],
   return status_word;
 }
 
+/**
+ * Services the host packets queued during the previous frame before every
+ * frame exchanged with the card, so that long chained exchanges keep
+ * answering status requests and register host aborts.
+ */
+static ret_code_t nfc_data_exchange(uint8_t *send_buff,
+                                    uint8_t send_len,
+                                    uint8_t *recv_buff,
+                                    uint8_t *recv_len) {
+  usb_process_rx_packets();
+  return adafruit_pn532_in_data_exchange(
+      send_buff, send_len, recv_buff, recv_len);
+}
+
+/**
+ * Card removal is told apart from other exchange failures only once an
+ * exchange failed, rather than probing the card presence before every APDU.
+ */
+static ret_code_t nfc_exchange_error(ret_code_t err_code) {
+  LOG_ERROR("err:%08X\n", err_code);
+  if (adafruit_diagnose_card_presence() != 0)
+    return NFC_CARD_ABSENT;
+  return err_code;
+}
+
+static ret_code_t nfc_decrypt_fragment(uint8_t *data, uint8_t *len) {
+  uint16_t data_len = *len;
+  ret_code_t err_code = apdu_decrypt_data(data, &data_len);
+
+  *len = data_len;
+  return err_code;
+}
+
+/**
+ * Collects every fragment of a chained response and then authenticates and
+ * decrypts the complete message once. Used with cards advertising
+ * CARD_CAP_WHOLE_MSG_SC, which send a single MAC and padding per message.
+ */
+static ret_code_t nfc_receive_whole_msg(uint8_t *recv_apdu,
+                                        uint16_t len,
+                                        uint16_t *recv_len) {
+  ret_code_t err_code = STM_SUCCESS;
+  uint8_t chain_pkt[] = {CLA_WHOLE_MSG_SC, 0xCF, 0x01, 0x00};
+  const uint16_t capacity = *recv_len;
+  uint8_t recv_pkt_len;
+
+  while (recv_apdu[len - 2] == 0x61) {
+    len -= 2;
+    /** The collected message may not outgrow the buffer of the caller */
+    if (capacity < len + 2)
+      return STM_ERROR_INVALID_LENGTH;
+    recv_pkt_len = (capacity - len) < RECV_PACKET_MAX_ENC_LEN
+                       ? capacity - len
+                       : RECV_PACKET_MAX_ENC_LEN;
+    err_code = nfc_data_exchange(
+        chain_pkt, sizeof(chain_pkt), recv_apdu + len, &recv_pkt_len);
+
+    if (err_code != STM_SUCCESS)
+      return nfc_exchange_error(err_code);
+    if (recv_pkt_len < 2)
+      return STM_ERROR_INVALID_LENGTH;
+    len += recv_pkt_len;
+    chain_pkt[OFFSET_P1]++;
+  }
+
+  if (len > 2 && (err_code = apdu_decrypt_data(recv_apdu, &len)) !=
+                     STM_SUCCESS)
+    return err_code;
+
+  adafruit_pn532_clear_buffers();
+  *recv_len = extract_card_data_health(recv_apdu, len);
+  return err_code;
+}
+
 ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
                              uint16_t send_len,
                              uint8_t *recv_apdu,
@@ -632,13 +802,11 @@ ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
   ASSERT(recv_len != NULL);
   ASSERT(send_len != 0);
 
-  ret_code_t err_code = adafruit_diagnose_card_presence();
-  if (err_code != 0)
-    return NFC_CARD_ABSENT;
-
+  ret_code_t err_code = STM_SUCCESS;
   uint8_t total_packets = 0, header[5], status[2] = {0};
-  uint8_t recv_pkt_len = 236, send_pkt_len;
+  uint8_t recv_pkt_len = 236, send_pkt_len, cla = 0x00;
   uint16_t off = OFFSET_CDATA;
+  const bool whole_msg = nfc_secure_comm && nfc_whole_msg_sc;
 
   memcpy(header, send_apdu, OFFSET_CDATA);
   if (nfc_secure_comm) {
@@ -653,11 +821,15 @@ ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
     send_len += sizeof(nfc_device_key_id);
     send_apdu[OFFSET_LC] += sizeof(nfc_device_key_id);
   }
+  if (whole_msg)
+    cla = CLA_WHOLE_MSG_SC;
 
-  total_packets = ceil(send_len / (1.0 * SEND_PACKET_MAX_LEN));
+  total_packets = ceil(send_len / (1.0 * nfc_frame_len));
   for (int packet = 1; packet <= total_packets;) {
-    recv_pkt_len = RECV_PACKET_MAX_ENC_LEN; /* On every request set acceptable
-                                               packet length */
+    /* On every request set acceptable packet length */
+    recv_pkt_len = RECV_PACKET_MAX_ENC_LEN;
+    if (whole_msg && *recv_len < recv_pkt_len)
+      recv_pkt_len = *recv_len;
 
     /**
      * Sets appropriate CLA byte for each packet. CLA byte (first byte of
@@ -667,38 +839,38 @@ ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
      * multi-packet APDU</li> <li>0x80 : Middle packets of a multi-packet
      * APDU</li>
      * </ul>
+     * CLA_WHOLE_MSG_SC is added to every packet of a whole-message protected
+     * command.
      */
     send_apdu[off - OFFSET_CDATA] =
-        packet == total_packets ? 0x00 : (packet == 1 ? 0x10 : 0x80);
+        cla | (packet == total_packets ? 0x00 : (packet == 1 ? 0x10 : 0x80));
 
     /** Copy rest of the header (INS,P1,P2,Lc : 4 bytes after CLA) as it is. */
     if (off > OFFSET_CDATA)
       memcpy(send_apdu + off - OFFSET_CDATA + 1, header + 1, OFFSET_CDATA - 1);
 
-    /** Fix on length of data to be sent in the current packet. @see
-     * SEND_PACKET_MAX_LEN puts an upper limit */
-    if ((send_len - off) > SEND_PACKET_MAX_LEN)
-      send_pkt_len = SEND_PACKET_MAX_LEN;
+    /** Fix on length of data to be sent in the current packet. The frame
+     * length negotiated with the card puts an upper limit */
+    if ((send_len - off) > nfc_frame_len)
+      send_pkt_len = nfc_frame_len;
     else
       send_pkt_len = send_len - off;
     send_apdu[off - 1] = send_pkt_len;
 
     /** Exchange the C-APDU */
-    err_code = adafruit_pn532_in_data_exchange(send_apdu + off - OFFSET_CDATA,
-                                               send_pkt_len + OFFSET_CDATA,
-                                               recv_apdu,
-                                               &recv_pkt_len);
+    err_code = nfc_data_exchange(send_apdu + off - OFFSET_CDATA,
+                                 send_pkt_len + OFFSET_CDATA,
+                                 recv_apdu,
+                                 &recv_pkt_len);
 
     /** Verify card's response. */
-    if (err_code != STM_SUCCESS) {
-      LOG_ERROR("err:%08X\n", err_code);
-      return err_code;
-    }
+    if (err_code != STM_SUCCESS)
+      return nfc_exchange_error(err_code);
     if (recv_pkt_len < 2)
       return STM_ERROR_INVALID_LENGTH;
     if (packet == total_packets)
       break;
-    off += SEND_PACKET_MAX_LEN;
+    off += nfc_frame_len;
 
     /**
      * Check if card properly handled the current packet and has sufficient
@@ -711,10 +883,13 @@ ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
     packet++;
   }
 
+  if (whole_msg)
+    return nfc_receive_whole_msg(recv_apdu, recv_pkt_len, recv_len);
+
   /** Check response status of received packet then decrypt the packet if
    * necessary */
   if (nfc_secure_comm && recv_pkt_len > 2)
-    err_code = apdu_decrypt_data(recv_apdu, &recv_pkt_len);
+    err_code = nfc_decrypt_fragment(recv_apdu, &recv_pkt_len);
   if (err_code != STM_SUCCESS)
     return err_code;
 
@@ -726,16 +901,14 @@ ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
   /** Request all the remaining packets of multi-packet response */
   while (recv_apdu[*recv_len - 2] == 0x61) {
     *recv_len -= 2;
-    err_code = adafruit_pn532_in_data_exchange(request_chain_pkt,
-                                               sizeof(request_chain_pkt),
-                                               recv_apdu + *recv_len,
-                                               &recv_pkt_len);
+    err_code = nfc_data_exchange(request_chain_pkt,
+                                 sizeof(request_chain_pkt),
+                                 recv_apdu + *recv_len,
+                                 &recv_pkt_len);
 
     /** Verify card's response */
-    if (err_code != STM_SUCCESS) {
-      LOG_ERROR("err:%08X\n", err_code);
-      return err_code;
-    }
+    if (err_code != STM_SUCCESS)
+      return nfc_exchange_error(err_code);
     if (recv_pkt_len < 2)
       return STM_ERROR_INVALID_LENGTH;
 
@@ -744,7 +917,7 @@ ret_code_t nfc_exchange_apdu(uint8_t *send_apdu,
     status[0] = recv_apdu[*recv_len + recv_pkt_len - 2];
     status[1] = recv_apdu[*recv_len + recv_pkt_len - 1];
     if (nfc_secure_comm && recv_pkt_len > 2)
-      err_code = apdu_decrypt_data(recv_apdu + *recv_len, &recv_pkt_len);
+      err_code = nfc_decrypt_fragment(recv_apdu + *recv_len, &recv_pkt_len);
     if (err_code != STM_SUCCESS)
       return err_code;
 
@@ -277,6 +277,24 @@ ISO7816 nfc_delete_wallet(const struct Wallet *wallet);
  */
 ISO7816 nfc_retrieve_wallet(struct Wallet *wallet);
 
+/**
+ * @brief Retrieve only the selected fields of a wallet in card
+ * @details
+ * Cards advertising CARD_CAP_SELECTIVE_RETRIEVE return only the requested
+ * fields, which shortens the secure channel exchange. Other cards, and cards
+ * rejecting the P1 of the request, fall back to nfc_retrieve_wallet(). Only
+ * the share or the arbitrary data, whichever the wallet holds, is expected in
+ * the response. The wallet is validated like in nfc_retrieve_wallet(), so the
+ * mask must hold the fields covered by the structure checksum.
+ *
+ * @param[in,out]   wallet      Wallet structure with the name, password and
+ *                              wallet info filled
+ * @param[in]       field_mask  Fields to retrieve, e.g. WALLET_FIELDS_FOR_SHARE
+ *
+ * @returns         ISO7816 Status Word
+ */
+ISO7816 nfc_retrieve_wallet_fields(struct Wallet *wallet, uint16_t field_mask);
+
 /**
  * @brief Sign data using card's private key
  * @details
@@ -402,8 +420,9 @@ ISO7816 nfc_decrypt_data(const uint8_t name[NAME_SIZE],
  * @param[in] send_apdu APDU to be sent
  * @param[in] send_len Length of APDU to be sent
  * @param[out] recv_apdu received APDU
- * @param[in,out] recv_len Expected length of received data and Length of
- * received data
+ * @param[in,out] recv_len Capacity of recv_apdu and Length of received data.
+ * A chained response of a card protecting whole messages is collected only
+ * while it fits the capacity.
  *
  * @returns ret_code_t STM_ERROR_CODE
  * @retval
@@ -74,6 +74,7 @@
 #include "assert_conf.h"
 #include "core.pb.h"
 #include "logger.h"
+#include "lz4_block.h"
 #include "pb_encode.h"
 #include "status_api.h"
 #include "sys_state.h"
@@ -104,13 +105,12 @@ typedef struct comm_raw_payload {
  * STATIC VARIABLES
  *****************************************************************************/
 
+static comm_slot_t comm_slots[COMM_SLOT_COUNT] = {0};
+
 /*****************************************************************************
  * GLOBAL VARIABLES
  *****************************************************************************/
 
-uint8_t comm_io_buffer[COMM_BUFFER_SIZE] = {0};
-comm_payload_t comm_payload;
-
 /*****************************************************************************
  * STATIC FUNCTION PROTOTYPES
  *****************************************************************************/
@@ -131,16 +131,42 @@ static bool is_there_any_msg_from_app() {
 
 void usb_init() {
 #if USE_SIMULATOR == 0
-  lusb_register_parserFunction(comm_packet_parser);
+  lusb_register_parserFunction(comm_packet_enqueue);
 #endif
 }
 
-uint8_t *get_io_buffer() {
-  return comm_io_buffer;
+comm_slot_t *comm_get_slot(comm_slot_owner_t owner) {
+  for (uint8_t i = 0; i < COMM_SLOT_COUNT; i++) {
+    if (owner == comm_slots[i].owner) {
+      return &comm_slots[i];
+    }
+  }
+  return NULL;
 }
 
-comm_payload_t *get_comm_payload() {
-  return &comm_payload;
+comm_slot_t *comm_get_rx_slot(void) {
+  comm_slot_t *slot = comm_get_slot(COMM_SLOT_TRANSPORT);
+
+  if (NULL == slot) {
+    slot = comm_get_slot(COMM_SLOT_FREE);
+  }
+  if (NULL == slot) {
+    // a new command means the host is done with the last response
+    slot = comm_get_slot(COMM_SLOT_OUTPUT);
+  }
+  if (NULL != slot) {
+    slot->owner = COMM_SLOT_TRANSPORT;
+  }
+  return slot;
+}
+
+void comm_release_slot(comm_slot_owner_t owner) {
+  comm_slot_t *slot = comm_get_slot(owner);
+
+  if (NULL != slot) {
+    comm_set_payload_struct(slot, 0, 0);
+    slot->owner = COMM_SLOT_FREE;
+  }
 }
 
 void mark_device_state(cy_app_status_t state, uint8_t flow_status) {
@@ -205,15 +231,29 @@ void usb_send_msg(const uint8_t *core_msg,
                   const uint8_t *app_msg,
                   uint32_t app_msg_size) {
   uint8_t usb_irq_enable = NVIC_GetEnableIRQ(OTG_FS_IRQn);
+  comm_slot_t *slot = NULL;
+  uint8_t *comm_io_buffer = NULL;
 
   NVIC_DisableIRQ(OTG_FS_IRQn);
   usb_clear_event();
   get_comm_status()->curr_cmd_state = CMD_STATE_DONE;
+  get_comm_status()->out_seq_no = get_comm_status()->curr_cmd_seq_no;
+
+  // the response replaces the previous one; the slot of a command being
+  // uploaded by the host is never used
+  slot = comm_get_slot(COMM_SLOT_FREE);
+  if (NULL == slot) {
+    slot = comm_get_slot(COMM_SLOT_OUTPUT);
+  }
+  ASSERT(NULL != slot);
+  comm_release_slot(COMM_SLOT_OUTPUT);
+  slot->owner = COMM_SLOT_OUTPUT;
+  comm_io_buffer = slot->buffer;
 
   // catch the buffer overflow situation
   ASSERT((COMM_SZ_RESERVED_SPACE + core_msg_size + app_msg_size) <=
          COMM_BUFFER_SIZE);
-  comm_set_payload_struct(core_msg_size, app_msg_size);
+  comm_set_payload_struct(slot, core_msg_size, app_msg_size);
 
   // write stream lengths into payload buffer as follows
   // core_msg_len (2-bytes) : app_msg_len (2-bytes) : core_msg : app_msg
@@ -243,7 +283,7 @@ void usb_send_msg(const uint8_t *core_msg,
 
 void usb_free_msg_buffer() {
   sys_flow_cntrl_u.bits.usb_buffer_free = true;
-  comm_set_payload_struct(0, 0);
+  comm_release_slot(COMM_SLOT_APP);
   LOG_SWV("%s\n", __func__);
 }
 
@@ -258,17 +298,18 @@ void usb_reset_state() {
 bool usb_get_msg(En_command_type_t *command_type,
                  uint8_t **msg_data,
                  uint16_t *msg_len) {
+  const comm_slot_t *slot = comm_get_slot(COMM_SLOT_APP);
   if ((msg_len == NULL && msg_data != NULL) ||
       (msg_len != NULL && msg_data == NULL))
     return false;
-  if (is_there_any_msg_from_app()) {
+  if (is_there_any_msg_from_app() && NULL != slot) {
     // TODO: Handle hybrid (raw and protobuf together) messages here
     if (command_type)
-      *command_type = U32_READ_BE_ARRAY(comm_payload.raw_data);
+      *command_type = U32_READ_BE_ARRAY(slot->payload.raw_data);
     if (msg_data)
-      *msg_data = comm_payload.raw_data + sizeof(uint32_t);
+      *msg_data = slot->payload.raw_data + sizeof(uint32_t);
     if (msg_len)
-      *msg_len = comm_payload.raw_data_length - sizeof(uint32_t);
+      *msg_len = slot->payload.raw_data_length - sizeof(uint32_t);
     return true;
   }
   return false;
@@ -277,27 +318,59 @@ bool usb_get_msg(En_command_type_t *command_type,
 bool get_usb_msg_by_cmd_type(En_command_type_t command_type,
                              uint8_t **msg_data,
                              uint16_t *msg_len) {
+  const comm_slot_t *slot = comm_get_slot(COMM_SLOT_APP);
   if ((msg_len == NULL && msg_data != NULL) ||
       (msg_len != NULL && msg_data == NULL))
     return false;
-  if (is_there_any_msg_from_app() &&
-      U32_READ_BE_ARRAY(comm_payload.raw_data) == command_type) {
+  if (is_there_any_msg_from_app() && NULL != slot &&
+      U32_READ_BE_ARRAY(slot->payload.raw_data) == command_type) {
     // TODO: Handle hybrid (raw and protobuf together) messages here
     if (msg_data)
-      *msg_data = comm_payload.raw_data + sizeof(uint32_t);
+      *msg_data = slot->payload.raw_data + sizeof(uint32_t);
     if (msg_len)
-      *msg_len = comm_payload.raw_data_length - sizeof(uint32_t);
+      *msg_len = slot->payload.raw_data_length - sizeof(uint32_t);
     return true;
   }
   return false;
 }
 
-void comm_set_payload_struct(uint16_t proto_len, uint16_t raw_len) {
-  comm_payload.proto_data_length = proto_len;
-  comm_payload.raw_data_length = raw_len;
-  comm_payload.proto_data =
-      proto_len ? comm_io_buffer + sizeof(uint16_t) * 2 : NULL;
-  comm_payload.raw_data = raw_len ? comm_io_buffer + 2 * sizeof(uint16_t) +
-                                        comm_payload.proto_data_length
-                                  : NULL;
+void comm_set_payload_struct(comm_slot_t *slot,
+                             uint16_t proto_len,
+                             uint16_t raw_len) {
+  comm_payload_t *comm_payload = &slot->payload;
+  comm_payload->proto_data_length = proto_len;
+  comm_payload->raw_data_length = raw_len;
+  comm_payload->proto_data =
+      proto_len ? slot->buffer + sizeof(uint16_t) * 2 : NULL;
+  comm_payload->raw_data = raw_len ? slot->buffer + 2 * sizeof(uint16_t) +
+                                         comm_payload->proto_data_length
+                                   : NULL;
+  comm_payload->compressed_length = 0;
+}
+
+bool comm_inflate_payload(void) {
+  comm_slot_t *slot = comm_get_slot(COMM_SLOT_APP);
+  if (NULL == slot) {
+    return true;
+  }
+
+  uint8_t *comm_io_buffer = slot->buffer;
+  comm_payload_t *comm_payload = &slot->payload;
+  const uint16_t compressed_length = comm_payload->compressed_length;
+  const int32_t size =
+      comm_payload->proto_data_length + comm_payload->raw_data_length;
+
+  if (0 == compressed_length) {
+    return true;
+  }
+  comm_payload->compressed_length = 0;
+
+  uint8_t *block = comm_io_buffer + COMM_BUFFER_SIZE - compressed_length;
+  // move the block to the end of the buffer to decompress it in place
+  memmove(block, comm_io_buffer + COMM_SZ_RESERVED_SPACE, compressed_length);
+  return size == lz4_block_decompress(block,
+                                      compressed_length,
+                                      comm_io_buffer + COMM_SZ_RESERVED_SPACE,
+                                      COMM_BUFFER_SIZE -
+                                          COMM_SZ_RESERVED_SPACE);
 }
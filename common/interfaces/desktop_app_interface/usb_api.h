@@ -68,6 +68,23 @@ typedef struct {
  */
 void usb_init();
 
+/**
+ * @brief Processes the packets queued by the USB receive interrupt.
+ * @details The interrupt only copies the raw packets into a ring; framing, CRC
+ * check, reassembly, acknowledgement and status replies happen here in thread
+ * context. It is called from the event loop, from long computations that
+ * yield and from the blocking card waits and exchanges in nfc.c, so that host
+ * status requests and aborts are serviced promptly. Any new loop that blocks
+ * for longer than a host status poll must call it as well.
+ */
+void usb_process_rx_packets(void);
+
+/**
+ * @brief Returns the count of host packets dropped because the receive ring
+ * was full when they arrived.
+ */
+uint32_t usb_get_rx_overflow_count(void);
+
 /**
  * @brief The function handles all the event cleanup operations.
  * @details The function will invalidate the existing usb event. In doing so, it
@@ -83,6 +100,15 @@ void usb_init();
  */
 void usb_clear_event();
 
+/**
+ * @brief Hands the buffer of the current usb event back to the usb module.
+ * @details To be called as soon as the message of the event is decoded, so that
+ * the host can upload its next command while the current one is processed. The
+ * message reference of the event is invalid afterwards. The event must still
+ * be responded to with usb_send_msg() or cleared with usb_clear_event().
+ */
+void usb_release_event_buffer(void);
+
 /**
  * @brief Getter for USB event object.
  * @details The function is a simple getter to return a valid USB Event object
@@ -93,10 +119,11 @@ void usb_clear_event();
  * NOTE:
  * Event receiver is expected to show a necessary action to the usb module.
  * This is majorly due to the shared reference to the static buffer of usb
- * module. It is important to note that when an usb event is available, it is
- * not possible to receive any new events. If the host tries to send new data
- * (except some special data packets), it will receive an error. Hence, it is
- * necessary to clear the usb event after it is consumed. When an application
+ * module. While an usb event is available, the host can upload one more command
+ * which is held by the usb module and only dispatched after the current event
+ * is responded to or cleared; any further data (except some special data
+ * packets) receives an error. Hence, it is necessary to clear the usb event
+ * after it is consumed. When an application
  * gets an usb event following scenarios might occur:
  *
  * <ol><li>
@@ -115,7 +142,7 @@ bool usb_get_event(usb_event_t *evt);
 /**
  * @brief Sends data stream to the host application over usb.
  * @details Allows applications to send data to the host. The functions
- * internally clears any existing usb event. This is due to the common buffer
+ * internally clears any existing usb event. This is due to the common buffers
  * used by the receive and transmit actions over usb. Hence, the applications
  * should make sure that any existing usb events are consumed before sending any
  * data.
@@ -32,6 +32,14 @@
 
 #define COMM_SZ_RESERVED_SPACE 4
 #define COMM_BUFFER_SIZE ((size_t)6 * 1024)
+/// Number of command buffers; the host can upload the next command into one
+/// while the application processes the command held by the other
+#define COMM_SLOT_COUNT 2
+
+/// Set in the core message length of a cmd payload whose core and app messages
+/// are sent as a single LZ4 block. The block follows the two length fields,
+/// which carry the decompressed sizes.
+#define COMM_PAYLOAD_COMPRESSED_FLAG 0x8000
 
 /*****************************************************************************
  * TYPEDEFS
@@ -115,8 +123,35 @@ typedef struct comm_payload {
                                ///< cmd payload
   uint8_t *proto_data;    ///< Protobuf serialization data in the cmd payload
   uint8_t *raw_data;      ///< Raw serialization data in the cmd payload
+  uint16_t compressed_length;    ///< Length of the LZ4 block of a compressed
+                                 ///< cmd payload not yet decompressed; else 0
 } comm_payload_t;
 
+/**
+ * @brief Owner of a command buffer
+ * @details A slot is owned by the transport while a command is received into it
+ * and until the command is delivered to the application. The application owns
+ * it until the command is decoded or responded to. The response is then held
+ * until the host starts sending another command.
+ */
+typedef enum comm_slot_owner {
+  COMM_SLOT_FREE = 0,
+  COMM_SLOT_TRANSPORT = 1,
+  COMM_SLOT_APP = 2,
+  COMM_SLOT_OUTPUT = 3,
+} comm_slot_owner_t;
+
+/**
+ * @brief Buffer of a single command or response along with its payload layout
+ *
+ * @see comm_payload_t, COMM_SLOT_COUNT
+ */
+typedef struct comm_slot {
+  uint8_t buffer[COMM_BUFFER_SIZE];
+  comm_payload_t payload;
+  comm_slot_owner_t owner;
+} comm_slot_t;
+
 /**
  * @brief Single package struct
  * @details
@@ -146,6 +181,16 @@ typedef struct comm_status {
   uint16_t curr_cmd_chunk_no;
   uint16_t curr_cmd_received_length;
 
+  // Command uploaded while the current one is being processed; it is delivered
+  // once the application is done with the current command
+  uint16_t next_cmd_seq_no;
+  uint8_t next_cmd_state;
+  uint16_t next_cmd_chunk_no;
+  uint16_t next_cmd_received_length;
+
+  // Sequence number of the command whose response is held for the host
+  uint16_t out_seq_no;
+
   // Host sync status (not to be sent to host)
   uint32_t host_sync_time;
   uint8_t host_sync_fails;
@@ -163,14 +208,35 @@ typedef struct comm_status {
  *****************************************************************************/
 
 /**
- * @brief Returns the reference to internal instance of io_buffer
+ * @brief Returns the slot held by the given owner
+ *
+ * @param owner Any owner except COMM_SLOT_FREE
+ * @return comm_slot_t* The slot or NULL if the owner holds none
  */
-uint8_t *get_io_buffer();
+comm_slot_t *comm_get_slot(comm_slot_owner_t owner);
 
 /**
- * @brief Returns the reference to internal instance of comm_payload
+ * @brief Returns the slot to receive a command into
+ * @details The slot already owned by the transport is returned if any; else a
+ * free slot or, failing that, the slot holding the last response is handed to
+ * the transport.
+ *
+ * @return comm_slot_t* The slot or NULL if all the slots are in use
  */
-comm_payload_t *get_comm_payload();
+comm_slot_t *comm_get_rx_slot(void);
+
+/**
+ * @brief Frees the slot held by the given owner, if any
+ *
+ * @param owner Any owner except COMM_SLOT_FREE
+ */
+void comm_release_slot(comm_slot_owner_t owner);
+
+/**
+ * @brief Delivers the command uploaded during the processing of the previous
+ * one, if any, once the application is done with the previous command
+ */
+void comm_deliver_next_cmd(void);
 
 /**
  * @brief Resets the active interface(to COMM_LIBUSB__UNDEFINED) used to
@@ -185,7 +251,20 @@ void comm_reset_interface(void);
  */
 comm_status_t *get_comm_status();
 
-void comm_set_payload_struct(uint16_t proto_len, uint16_t raw_len);
+void comm_set_payload_struct(comm_slot_t *slot,
+                             uint16_t proto_len,
+                             uint16_t raw_len);
+
+/**
+ * @brief Decompresses a compressed cmd payload in place
+ * @details The LZ4 block is moved to the end of the io buffer and decompressed
+ * to its regular position after the length fields, so no additional buffer is
+ * needed. Does nothing for an uncompressed payload. Must be called before the
+ * payload is consumed, outside of the USB interrupt.
+ *
+ * @return true if the payload is ready for use, false if the block was invalid
+ */
+bool comm_inflate_payload(void);
 
 /**
  * @brief  Update CRC16 for input byte
@@ -202,6 +281,19 @@ void comm_set_payload_struct(uint16_t proto_len, uint16_t raw_len);
  */
 uint16_t update_crc16(uint16_t crc_in, uint8_t byte);
 
+/**
+ * @brief Queues a packet received from the host for usb_process_rx_packets()
+ * @details Called from the USB receive interrupt. Only copies the packet into
+ * the receive ring; the packet is dropped and counted if the ring is full.
+ *
+ * @param data Packet received from the host
+ * @param length Length of the packet
+ * @param interface Interface the packet was received on
+ */
+void comm_packet_enqueue(const uint8_t *data,
+                         const uint16_t length,
+                         comm_libusb__interface_e interface);
+
 /**
  * @brief Send a packet to the host
  * @details This function aggregates a received packet from the host.
@@ -231,6 +231,12 @@ void usb_clear_event() {
   usb_reset_state();
 }
 
+void usb_release_event_buffer(void) {
+  reset_event_obj(&usb_event);
+  clear_msg_context();
+  usb_free_msg_buffer();
+}
+
 void usb_set_event(const uint16_t core_msg_size,
                    const uint8_t *core_msg_buffer,
                    const uint16_t app_msg_size,
@@ -251,8 +257,16 @@ bool usb_get_event(usb_event_t *evt) {
   size_t request_type = 0;
   reset_event_obj(evt);
 
+  if (!usb_event.flag) {
+    // the command uploaded during the previous one, if any
+    comm_deliver_next_cmd();
+  }
+
   if (usb_event.flag) {
-    core_error_type_t status = get_core_req_type(core_msg, &request_type);
+    core_error_type_t status = CORE_INVALID_MSG;
+    if (comm_inflate_payload()) {
+      status = get_core_req_type(core_msg, &request_type);
+    }
     if (CORE_NO_ERROR != status) {
       // now clear event as it is not supposed to reach the app
       usb_clear_event();
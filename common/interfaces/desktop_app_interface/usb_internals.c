@@ -86,6 +86,13 @@
  * PRIVATE MACROS AND DEFINES
  *****************************************************************************/
 
+// Logs on every packet; can be trimmed independently of LOG_LEVEL
+#ifndef USB_INTERNALS_LOG_LEVEL
+#define USB_INTERNALS_LOG_LEVEL LOG_LEVEL
+#endif
+#undef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL USB_INTERNALS_LOG_LEVEL
+
 #define COMM_HEADER_INDEX 0
 #define COMM_CHECKSUM_INDEX 2
 #define COMM_CHUNK_NO_INDEX 4
@@ -140,8 +147,9 @@ static comm_error_code_t comm_process_out_req_packet(const packet_t *rx_packet);
 static comm_error_code_t comm_process_abort_packet(const packet_t *rx_packet);
 
 static void send_status_packet(const packet_t *rx_packet);
-static void send_cmd_ack_packet(const packet_t *rx_packet);
-static void send_cmd_output_packet(const packet_t *rx_packet);
+static void send_cmd_ack_packet(const packet_t *rx_packet, uint16_t chunk_no);
+static void send_cmd_output_packet(const packet_t *rx_packet,
+                                   const comm_slot_t *slot);
 
 static void comm_write_packet(uint16_t chunk_number,
                               uint16_t total_chunks,
@@ -177,71 +185,179 @@ static comm_error_code_t comm_process_status_packet(const packet_t *rx_packet) {
 }
 
 /**
- * @details Packet type: PKT_TYPE_CMD <br/>
+ * @brief Appends a chunk of a command to the slot owned by the transport
+ * @details Shared by the current command and the command uploaded while the
+ * current one is processed, which only differ in where their sequence number,
+ * state and receive progress are tracked.
  *
+ * @param rx_packet Received command packet
+ * @param seq_no Sequence number of the command being received
+ * @param state State of the command; CMD_STATE_RECEIVED once complete
+ * @param chunk_no Last chunk number appended for the command
+ * @param received_length Bytes of the command received so far
+ * @return comm_error_code_t NO_ERROR if the chunk is accepted
  */
-static comm_error_code_t comm_process_cmd_packet(const packet_t *rx_packet) {
-  uint8_t *comm_io_buffer = get_io_buffer();
-  comm_payload_t *comm_payload = get_comm_payload();
-  if (!CY_Usb_Buffer_Free())
+static comm_error_code_t comm_receive_chunk(const packet_t *rx_packet,
+                                            uint16_t *seq_no,
+                                            uint8_t *state,
+                                            uint16_t *chunk_no,
+                                            uint16_t *received_length) {
+  comm_slot_t *slot = comm_get_rx_slot();
+  if (NULL == slot)
     return APP_BUFFER_BLOCKED;
-  if (comm_status.curr_cmd_state == CMD_STATE_EXECUTING)
-    return BUSY_PREVIOUS_CMD;
-
-  // Set active host interface if not set already
-  if (comm_status.active_interface == COMM_LIBUSB__UNDEFINED) {
-    comm_status.active_interface = rx_packet->interface;
-  } else if (comm_status.active_interface != rx_packet->interface) {
-    return APP_BUSY_WITH_OTHER_INTERFACE;
+  uint8_t *comm_io_buffer = slot->buffer;
+
+  *state = CMD_STATE_RECEIVING;
+  if (*seq_no != rx_packet->header.sequence_no ||
+      rx_packet->header.chunk_number == 1) {
+    // Clear current status and start new command
+    *received_length = 0;
+    *chunk_no = 0;
   }
 
-  comm_status.curr_cmd_state = CMD_STATE_RECEIVING;
-  if (comm_status.curr_cmd_seq_no != rx_packet->header.sequence_no ||
-      rx_packet->header.chunk_number == 1)
-    comm_reset();    // Clear current status and start new command
-
-  if (comm_status.curr_cmd_chunk_no + 1 < rx_packet->header.chunk_number)
+  if (*chunk_no + 1 < rx_packet->header.chunk_number)
     return OUT_OF_ORDER_CHUNK;
   if (rx_packet->header.chunk_number > rx_packet->header.total_chunks)
     return INVALID_CHUNK_COUNT;
 
-  comm_status.curr_cmd_seq_no = rx_packet->header.sequence_no;
-  if (comm_status.curr_cmd_chunk_no + 1 == rx_packet->header.chunk_number) {
+  *seq_no = rx_packet->header.sequence_no;
+  if (*chunk_no + 1 == rx_packet->header.chunk_number) {
     // Duplicate packets are ignored; Only packets in expected sequence are
     // appended to buffer
-    comm_status.curr_cmd_chunk_no = rx_packet->header.chunk_number;
-    memcpy(comm_io_buffer + comm_status.curr_cmd_received_length,
+    *chunk_no = rx_packet->header.chunk_number;
+    memcpy(comm_io_buffer + *received_length,
            rx_packet->payload,
            rx_packet->header.payload_length);
-    comm_status.curr_cmd_received_length += rx_packet->header.payload_length;
+    *received_length += rx_packet->header.payload_length;
     if (rx_packet->header.chunk_number == rx_packet->header.total_chunks) {
       // Last chunk received
-      if (comm_status.curr_cmd_received_length !=
-          (U16_READ_BE_ARRAY(comm_io_buffer) +
-           U16_READ_BE_ARRAY(comm_io_buffer + sizeof(uint16_t)) +
-           sizeof(uint16_t) * 2)) {
+      const uint16_t total_length = *received_length;
+      uint16_t proto_length = U16_READ_BE_ARRAY(comm_io_buffer);
+      uint16_t raw_length =
+          U16_READ_BE_ARRAY(comm_io_buffer + sizeof(uint16_t));
+      uint16_t compressed_length = 0;
+      bool valid = false;
+
+      if (proto_length & COMM_PAYLOAD_COMPRESSED_FLAG) {
+        // decompressed later by comm_inflate_payload() when the command is
+        // consumed; only the bounds are checked while receiving
+        proto_length &= ~COMM_PAYLOAD_COMPRESSED_FLAG;
+        valid = (sizeof(uint16_t) * 2 < total_length &&
+                 (proto_length + raw_length + sizeof(uint16_t) * 2) <=
+                     COMM_BUFFER_SIZE);
+        compressed_length = total_length - sizeof(uint16_t) * 2;
+      } else {
+        valid = (total_length ==
+                 (proto_length + raw_length + sizeof(uint16_t) * 2));
+      }
+
+      if (!valid) {
         LOG_SWV("#RED#Invalid payload length: %d + %d + 4 != %d\n",
-                U16_READ_BE_ARRAY(comm_io_buffer),
-                U16_READ_BE_ARRAY(comm_io_buffer + sizeof(uint16_t)),
-                comm_status.curr_cmd_received_length);
-        comm_reset();
+                proto_length,
+                raw_length,
+                total_length);
+        *received_length = 0;
+        *chunk_no = 0;
+        *state = CMD_STATE_NONE;
         return INVALID_PAYLOAD_LENGTH;
       } else {
-        sys_flow_cntrl_u.bits.usb_buffer_free = false;
-        comm_set_payload_struct(
-            U16_READ_BE_ARRAY(comm_io_buffer),
-            U16_READ_BE_ARRAY(comm_io_buffer + sizeof(uint16_t)));
+        comm_set_payload_struct(slot, proto_length, raw_length);
+        slot->payload.compressed_length = compressed_length;
       }
     }
   }
-  if (rx_packet->header.chunk_number == rx_packet->header.total_chunks) {
-    comm_status.curr_cmd_state = CMD_STATE_RECEIVED;
-    usb_set_event(comm_payload->proto_data_length,
-                  comm_payload->proto_data,
-                  comm_payload->raw_data_length,
-                  comm_payload->raw_data);
+  if (rx_packet->header.chunk_number == rx_packet->header.total_chunks)
+    *state = CMD_STATE_RECEIVED;
+  return NO_ERROR;
+}
+
+/**
+ * @brief Hands a completely received command over to the application
+ */
+static void comm_deliver_cmd(comm_slot_t *slot) {
+  slot->owner = COMM_SLOT_APP;
+  sys_flow_cntrl_u.bits.usb_buffer_free = false;
+  usb_set_event(slot->payload.proto_data_length,
+                slot->payload.proto_data,
+                slot->payload.raw_data_length,
+                slot->payload.raw_data);
+}
+
+/**
+ * @details Packet type: PKT_TYPE_CMD <br/>
+ * Receives a command while the current one is received or executed by the
+ * application. The command is acknowledged so that the host can complete the
+ * upload and is held in the other slot until comm_deliver_next_cmd(). A single
+ * command is held at a time.
+ */
+static comm_error_code_t comm_process_next_cmd_packet(
+    const packet_t *rx_packet) {
+  comm_error_code_t error = NO_ERROR;
+
+  if (comm_status.next_cmd_state == CMD_STATE_NONE &&
+      comm_status.curr_cmd_seq_no == rx_packet->header.sequence_no) {
+    return comm_status.curr_cmd_state == CMD_STATE_RECEIVED
+               ? APP_BUFFER_BLOCKED
+               : BUSY_PREVIOUS_CMD;
+  }
+  if (comm_status.next_cmd_state == CMD_STATE_RECEIVED) {
+    if (comm_status.next_cmd_seq_no != rx_packet->header.sequence_no)
+      return APP_BUFFER_BLOCKED;
+    // Duplicate of a chunk of the held command
+    send_cmd_ack_packet(rx_packet, comm_status.next_cmd_chunk_no);
+    return NO_ERROR;
+  }
+
+  error = comm_receive_chunk(rx_packet,
+                             &comm_status.next_cmd_seq_no,
+                             &comm_status.next_cmd_state,
+                             &comm_status.next_cmd_chunk_no,
+                             &comm_status.next_cmd_received_length);
+  if (error != NO_ERROR)
+    return error;
+
+  send_cmd_ack_packet(rx_packet, comm_status.next_cmd_chunk_no);
+  LOG_SWV("#ORG#next: cs=%d, seq=%d, ncn=%d, ncc=%d, rl=%d\n",
+          comm_status.next_cmd_state,
+          comm_status.next_cmd_seq_no,
+          comm_status.next_cmd_chunk_no,
+          rx_packet->header.total_chunks,
+          comm_status.next_cmd_received_length);
+  return NO_ERROR;
+}
+
+/**
+ * @details Packet type: PKT_TYPE_CMD <br/>
+ *
+ */
+static comm_error_code_t comm_process_cmd_packet(const packet_t *rx_packet) {
+  comm_error_code_t error = NO_ERROR;
+
+  // Set active host interface if not set already
+  if (comm_status.active_interface == COMM_LIBUSB__UNDEFINED) {
+    comm_status.active_interface = rx_packet->interface;
+  } else if (comm_status.active_interface != rx_packet->interface) {
+    return APP_BUSY_WITH_OTHER_INTERFACE;
+  }
+
+  if (comm_status.curr_cmd_state == CMD_STATE_RECEIVED ||
+      comm_status.curr_cmd_state == CMD_STATE_EXECUTING ||
+      comm_status.next_cmd_state != CMD_STATE_NONE) {
+    return comm_process_next_cmd_packet(rx_packet);
+  }
+
+  error = comm_receive_chunk(rx_packet,
+                             &comm_status.curr_cmd_seq_no,
+                             &comm_status.curr_cmd_state,
+                             &comm_status.curr_cmd_chunk_no,
+                             &comm_status.curr_cmd_received_length);
+  if (error != NO_ERROR)
+    return error;
+
+  if (comm_status.curr_cmd_state == CMD_STATE_RECEIVED) {
+    comm_deliver_cmd(comm_get_slot(COMM_SLOT_TRANSPORT));
   }
-  send_cmd_ack_packet(rx_packet);
+  send_cmd_ack_packet(rx_packet, comm_status.curr_cmd_chunk_no);
   LOG_SWV("#ORG#bs=%d, cs=%d, seq=%d, ccn=%d, ccc=%d, rl=%d\n",
           CY_Usb_Buffer_Free(),
           comm_status.curr_cmd_state,
@@ -262,8 +378,12 @@ static comm_error_code_t comm_process_cmd_packet(const packet_t *rx_packet) {
  */
 static comm_error_code_t comm_process_out_req_packet(
     const packet_t *rx_packet) {
-  comm_payload_t *comm_payload = get_comm_payload();
-  if (comm_status.curr_cmd_seq_no != rx_packet->header.sequence_no)
+  // The response stays available after the next command is delivered
+  const comm_slot_t *slot = comm_get_slot(COMM_SLOT_OUTPUT);
+  if (NULL != slot && comm_status.out_seq_no != rx_packet->header.sequence_no)
+    slot = NULL;
+  if (NULL == slot &&
+      comm_status.curr_cmd_seq_no != rx_packet->header.sequence_no)
     return INVALID_SEQUENCE_NO;
   if (rx_packet->header.chunk_number != 1)
     return INVALID_CHUNK_NO;
@@ -271,16 +391,16 @@ static comm_error_code_t comm_process_out_req_packet(
     return INVALID_CHUNK_COUNT;
   if (rx_packet->header.payload_length != 6)
     return INVALID_PAYLOAD_LENGTH;
-  if (comm_status.curr_cmd_state != CMD_STATE_DONE &&
-      comm_status.curr_cmd_state != CMD_STATE_FAILED) {
+  if (NULL == slot) {
     send_status_packet(rx_packet);
     return NO_ERROR;
   }
+  const comm_payload_t *comm_payload = &slot->payload;
   if ((U16_READ_BE_ARRAY(rx_packet->payload + 4) - 1) * COMM_MAX_PAYLOAD_SIZE >
       comm_get_payload_size(comm_payload))
     return NO_MORE_CHUNKS;    // Invalid output chunk request
 
-  send_cmd_output_packet(rx_packet);
+  send_cmd_output_packet(rx_packet, slot);
   return NO_ERROR;
 }
 
@@ -296,7 +416,13 @@ static comm_error_code_t comm_process_abort_packet(const packet_t *rx_packet) {
     CY_Reset_Flow();
     p0_set_abort_evt(true);
     comm_status.curr_cmd_seq_no = rx_packet->header.sequence_no;
+    comm_status.next_cmd_state = CMD_STATE_NONE;
+    comm_status.next_cmd_chunk_no = 0;
+    comm_status.next_cmd_received_length = 0;
     sys_flow_cntrl_u.bits.usb_buffer_free = true;
+    comm_release_slot(COMM_SLOT_TRANSPORT);
+    comm_release_slot(COMM_SLOT_APP);
+    comm_release_slot(COMM_SLOT_OUTPUT);
   }
 
   send_status_packet(rx_packet);
@@ -340,15 +466,15 @@ static void send_status_packet(const packet_t *rx_packet) {
                     rx_packet->interface);
 }
 
-static void send_cmd_ack_packet(const packet_t *rx_packet) {
+static void send_cmd_ack_packet(const packet_t *rx_packet, uint16_t chunk_no) {
   uint8_t payload[3 * sizeof(uint16_t)] = {0};
   uint8_t offset = 0;
   payload[offset++] = 0x00;
   payload[offset++] = 0x00;    // proto length
   payload[offset++] = 0x00;
   payload[offset++] = 0x02;    // raw length
-  payload[offset++] = (comm_status.curr_cmd_chunk_no >> 8) & 0xFF;
-  payload[offset++] = comm_status.curr_cmd_chunk_no & 0xFF;
+  payload[offset++] = (chunk_no >> 8) & 0xFF;
+  payload[offset++] = chunk_no & 0xFF;
   comm_write_packet(1,
                     1,
                     rx_packet->header.sequence_no,
@@ -358,9 +484,10 @@ static void send_cmd_ack_packet(const packet_t *rx_packet) {
                     rx_packet->interface);
 }
 
-static void send_cmd_output_packet(const packet_t *rx_packet) {
-  comm_payload_t *comm_payload = get_comm_payload();
-  uint8_t *comm_io_buffer = get_io_buffer();
+static void send_cmd_output_packet(const packet_t *rx_packet,
+                                   const comm_slot_t *slot) {
+  const comm_payload_t *comm_payload = &slot->payload;
+  const uint8_t *comm_io_buffer = slot->buffer;
   ASSERT(comm_payload->raw_data != NULL || comm_payload->proto_data != NULL);
   uint16_t req_chunk_no = U16_READ_BE_ARRAY(
       rx_packet->payload +
@@ -432,6 +559,22 @@ comm_status_t *get_comm_status() {
   return &comm_status;
 }
 
+void comm_deliver_next_cmd(void) {
+  if (comm_status.next_cmd_state != CMD_STATE_RECEIVED ||
+      comm_status.curr_cmd_state == CMD_STATE_RECEIVED ||
+      comm_status.curr_cmd_state == CMD_STATE_EXECUTING)
+    return;
+
+  comm_status.curr_cmd_seq_no = comm_status.next_cmd_seq_no;
+  comm_status.curr_cmd_state = CMD_STATE_RECEIVED;
+  comm_status.curr_cmd_chunk_no = comm_status.next_cmd_chunk_no;
+  comm_status.curr_cmd_received_length = comm_status.next_cmd_received_length;
+  comm_status.next_cmd_state = CMD_STATE_NONE;
+  comm_status.next_cmd_chunk_no = 0;
+  comm_status.next_cmd_received_length = 0;
+  comm_deliver_cmd(comm_get_slot(COMM_SLOT_TRANSPORT));
+}
+
 void comm_process_packet(const packet_t *rx_packet) {
   static uint8_t temp_type = 0;
   if (temp_type != rx_packet->header.packet_type) {
@@ -65,6 +65,8 @@
 #if USE_SIMULATOR == 0
 #include "libusb.h"
 #endif
+#include "packet_ring.h"
+#include "usb_api.h"
 #include "usb_api_priv.h"
 #include "utils.h"
 
@@ -78,6 +80,10 @@
 
 #define COMM_V0_START_OF_HEADER 0xAA
 
+// Host packets that can be queued by the USB interrupt before being processed;
+// must be a power of two
+#define COMM_RX_RING_SLOTS 8
+
 /*****************************************************************************
  * PRIVATE TYPEDEFS
  *****************************************************************************/
@@ -152,6 +158,16 @@ static uint8_t SDK_RESP_PACKET[] = {
     0x90    // Checksum
 };
 
+static uint8_t rx_ring_buffer[COMM_RX_RING_SLOTS * COMM_PKT_MAX_LEN];
+static packet_ring_slot_t rx_ring_slots[COMM_RX_RING_SLOTS];
+static packet_ring_t rx_ring = {.buffer = rx_ring_buffer,
+                                .slots = rx_ring_slots,
+                                .slot_size = COMM_PKT_MAX_LEN,
+                                .slot_count = COMM_RX_RING_SLOTS,
+                                .head = 0,
+                                .tail = 0,
+                                .overflow_count = 0};
+
 /*****************************************************************************
  * GLOBAL VARIABLES
  *****************************************************************************/
@@ -296,3 +312,24 @@ void comm_packet_parser(const uint8_t *data,
     memzero(&rx_packet, sizeof(rx_packet));
   }
 }
+
+void comm_packet_enqueue(const uint8_t *data,
+                         const uint16_t length,
+                         comm_libusb__interface_e interface) {
+  packet_ring_push(&rx_ring, (uint8_t)interface, data, length);
+}
+
+void usb_process_rx_packets(void) {
+  uint8_t interface = 0;
+  const uint8_t *data = NULL;
+  uint16_t length = 0;
+
+  while (packet_ring_peek(&rx_ring, &interface, &data, &length)) {
+    comm_packet_parser(data, length, (comm_libusb__interface_e)interface);
+    packet_ring_pop(&rx_ring);
+  }
+}
+
+uint32_t usb_get_rx_overflow_count(void) {
+  return packet_ring_get_overflow_count(&rx_ring);
+}
@@ -302,6 +302,9 @@ int delete_wallet_from_flash(const uint8_t wallet_index) {
   flash_ram_instance.wallets[wallet_index].state = DEFAULT_VALUE_IN_FLASH;
   flash_ram_instance.wallets[wallet_index].cards_states = 0;
   memset(flash_ram_instance.wallets[wallet_index].wallet_name, 0, NAME_SIZE);
+  memset(flash_ram_instance.wallets[wallet_index].seed_tag,
+         0,
+         WALLET_SEED_TAG_SIZE);
   flash_struct_save();
   return SUCCESS_;
 }
@@ -878,6 +881,24 @@ int set_wallet_state(const uint8_t wallet_index, const wallet_state new_state) {
   return SUCCESS_;
 }
 
+int set_wallet_seed_tag(const uint8_t wallet_index,
+                        const uint8_t seed_tag[WALLET_SEED_TAG_SIZE]) {
+  ASSERT(wallet_index < MAX_WALLETS_ALLOWED);
+  ASSERT(seed_tag != NULL);
+
+  get_flash_ram_instance();
+  if (wallet_index >= MAX_WALLETS_ALLOWED)
+    return INVALID_ARGUMENT;
+  if (!_wallet_is_filled(wallet_index))
+    return INVALID_ARGUMENT;
+
+  memcpy(flash_ram_instance.wallets[wallet_index].seed_tag,
+         seed_tag,
+         WALLET_SEED_TAG_SIZE);
+  flash_struct_save();
+  return SUCCESS_;
+}
+
 int set_display_rotation(const display_rotation _rotation,
                          flash_save_mode save_mode) {
   get_flash_ram_instance();
@@ -1119,6 +1140,21 @@ const uint8_t *get_wallet_name(uint8_t wallet_index) {
   return flash_ram_instance.wallets[wallet_index].wallet_name;
 }
 
+const uint8_t *get_wallet_seed_tag(uint8_t wallet_index) {
+  if (wallet_index >= MAX_WALLETS_ALLOWED)
+    return NULL;
+
+  get_flash_ram_instance();
+  const uint8_t *seed_tag = flash_ram_instance.wallets[wallet_index].seed_tag;
+  bool all_zero = true, all_erased = true;
+  for (uint8_t i = 0; i < WALLET_SEED_TAG_SIZE; i++) {
+    all_zero &= (0x00 == seed_tag[i]);
+    all_erased &= (DEFAULT_VALUE_IN_FLASH == seed_tag[i]);
+  }
+  // Wallets created before the check value was introduced are not enrolled
+  return (all_zero || all_erased) ? NULL : seed_tag;
+}
+
 const uint8_t get_wallet_count() {
   get_flash_ram_instance();
   return flash_ram_instance.wallet_count;
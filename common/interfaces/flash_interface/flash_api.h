@@ -406,6 +406,27 @@ int save_nonce_flash(const char *name,
  */
 int set_wallet_state(uint8_t wallet_index, wallet_state new_state);
 
+/**
+ * @brief Stores the check value of the wallet entropy in flash
+ *
+ * @param wallet_index Wallet index in flash
+ * @param seed_tag Check value computed by calculate_seed_tag()
+ * @return INVALID_ARGUMENT, SUCCESS
+ * @retval INVALID_ARGUMENT Invalid index or wallet not present
+ * @retval SUCCESS Check value stored successfully
+ */
+int set_wallet_seed_tag(uint8_t wallet_index,
+                        const uint8_t seed_tag[WALLET_SEED_TAG_SIZE]);
+
+/**
+ * @brief Returns the check value of the wallet entropy stored in flash
+ *
+ * @param wallet_index Wallet index in flash
+ * @return const uint8_t* The check value of WALLET_SEED_TAG_SIZE bytes, NULL
+ * if the index is invalid or the wallet is not enrolled yet
+ */
+const uint8_t *get_wallet_seed_tag(uint8_t wallet_index);
+
 /**
  * @brief Set the display rotation
  *
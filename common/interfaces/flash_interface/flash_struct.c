@@ -76,13 +76,13 @@
  *
  * The first 6 bytes consist of 4 bytes of TAG_FLASH_STRUCT + 2 bytes of total
  * structure size. In the calculation 3 is the size of TAG (1 byte) + size of
- * LENGTH (2 bytes) and 15 is the number of times the TAG, LENGTH, VALUE
+ * LENGTH (2 bytes) and 16 is the number of times the TAG, LENGTH, VALUE
  * combination occurs in Flash_Wallet. The number of tags of Flash_Pow are
- * included in the 15 number.
+ * included in the 16 number.
  */
 #define FLASH_STRUCT_TLV_SIZE                                                  \
   (6 + 3 + FAMILY_ID_SIZE + 3 + sizeof(uint32_t) + 3 +                         \
-   (MAX_WALLETS_ALLOWED * ((15 * 3) + sizeof(Flash_Wallet))) + 3 +             \
+   (MAX_WALLETS_ALLOWED * ((16 * 3) + sizeof(Flash_Wallet))) + 3 +             \
    sizeof(uint8_t) + 3 + sizeof(uint8_t) + 3 + sizeof(uint8_t) + 3 +           \
    sizeof(uint8_t))
 
@@ -117,6 +117,7 @@ typedef enum Flash_tlv_tags {
   TAG_FLASH_WALLET_LOCKED = 0x27,
   TAG_FLASH_WALLET_CHALLENGE = 0x28,
   TAG_FLASH_WALLET_ID = 0x29,
+  TAG_FLASH_WALLET_SEED_TAG = 0x2A,
 
   TAG_FLASH_WALLET_CHALLENGE_TARGET = 0x40,
   TAG_FLASH_WALLET_CHALLENGE_RANDOM_NUMBER = 0x41,
@@ -129,8 +130,8 @@ typedef enum Flash_tlv_tags {
 Flash_Struct flash_ram_instance;
 bool is_flash_ram_instance_loaded = false;
 
-static void deserialize_fs(Flash_Struct *flash_struct, uint8_t *tlv);
-static uint16_t serialize_fs(const Flash_Struct *flash_struct, uint8_t *tlv);
+STATIC void deserialize_fs(Flash_Struct *flash_struct, uint8_t *tlv);
+STATIC uint16_t serialize_fs(const Flash_Struct *flash_struct, uint8_t *tlv);
 
 /**
  * @brief Load flash struct instance
@@ -368,6 +369,11 @@ static void serialize_fs_wallet(uint8_t *array,
                    TAG_FLASH_WALLET_ID,
                    WALLET_ID_SIZE,
                    (uint8_t *)(&(wallet->wallet_id)));
+    fill_flash_tlv(array,
+                   starting_index,
+                   TAG_FLASH_WALLET_SEED_TAG,
+                   WALLET_SEED_TAG_SIZE,
+                   (uint8_t *)(&(wallet->seed_tag)));
 
     array[len_index] = (*starting_index) - len_index - 2;
     array[len_index + 1] = ((*starting_index) - len_index - 2) >> 8;
@@ -386,7 +392,7 @@ static void serialize_fs_wallet(uint8_t *array,
  * @param tlv TLV array
  * @return uint32_t Size of the TLV
  */
-static uint16_t serialize_fs(const Flash_Struct *flash_struct, uint8_t *tlv) {
+STATIC uint16_t serialize_fs(const Flash_Struct *flash_struct, uint8_t *tlv) {
   tlv[0] = (uint8_t)(TAG_FLASH_STRUCT);
   tlv[1] = (uint8_t)(TAG_FLASH_STRUCT >> 8);
   tlv[2] = (uint8_t)(TAG_FLASH_STRUCT >> 16);
@@ -534,6 +540,11 @@ static void deserialize_fs_wallet(Flash_Wallet *flash_wallet,
         break;
       }
 
+      case TAG_FLASH_WALLET_SEED_TAG: {
+        memcpy(flash_wallet->seed_tag, tlv + index + 2, size);
+        break;
+      }
+
       default: {
         break;
       }
@@ -548,7 +559,7 @@ static void deserialize_fs_wallet(Flash_Wallet *flash_wallet,
  * @param flash_struct Pointer to Flash_Struct instance to store the values
  * @param tlv TLV byte array
  */
-static void deserialize_fs(Flash_Struct *flash_struct, uint8_t *tlv) {
+STATIC void deserialize_fs(Flash_Struct *flash_struct, uint8_t *tlv) {
   uint16_t index = 4;    // First 4 bytes are the TAG_FLASH_STRUCT
   uint16_t len = tlv[index] + (tlv[index + 1] << 8) + 6;
 
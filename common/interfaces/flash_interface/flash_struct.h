@@ -100,6 +100,9 @@ typedef struct Flash_Wallet {
                            // and cleared when successful.
   uint8_t is_wallet_locked;    // 1 if wallet if locked
   Flash_Pow challenge;
+  uint8_t seed_tag[WALLET_SEED_TAG_SIZE];    // check value of the wallet
+                                             // entropy; all 0x00 or 0xFF if
+                                             // not enrolled yet
 } Flash_Wallet;
 #pragma pack(pop)
 
@@ -63,11 +63,15 @@
 #include "dev_utils.h"
 #endif
 
+// Room left for the chunk arrows on either side of a chunked address
+#define ADDRESS_CHUNK_WIDTH (LV_HOR_RES - 24)
+#define ADDRESS_FULL_WIDTH (LV_HOR_RES - 4)
+
+static struct Address_Data address_data;
+static struct Address_Object address_obj;
 static struct Address_Data *data = NULL;
 static struct Address_Object *obj = NULL;
 
-extern lv_task_t *address_timeout_task;
-
 /**
  * @brief Create address screen
  * @details
@@ -84,6 +88,62 @@ extern lv_task_t *address_timeout_task;
  */
 static void address_scr_create(bool hide_buttons);
 
+/**
+ * @brief Splits the address into chunks fitting the given width
+ * @details The glyph widths of the font are used, so each chunk is exactly as
+ * wide as the label can show without scrolling. Anything beyond
+ * ADDRESS_MAX_CHUNKS is appended to the last chunk.
+ *
+ * @param address Address to be split
+ * @param style Style of the address label
+ * @param max_w Width available for a chunk
+ *
+ * @return
+ * @retval
+ *
+ * @see
+ * @since v1.0.0
+ *
+ * @note
+ */
+static void split_address(const char address[],
+                          const lv_style_t *style,
+                          const lv_coord_t max_w) {
+  ASSERT(data != NULL);
+
+  const lv_font_t *font = style->text.font;
+  uint32_t i = 0;
+  uint16_t out = 0;
+  lv_coord_t width = 0;
+
+  data->chunk_count = 1;
+  data->chunk_offset[0] = 0;
+
+  while ('\0' != address[i]) {
+    uint32_t start = i;
+    uint32_t letter = lv_txt_encoded_next(address, &i);
+    uint32_t letter_next = lv_txt_encoded_next(&address[i], NULL);
+    lv_coord_t letter_w = lv_font_get_glyph_width(font, letter, letter_next) +
+                          style->text.letter_space;
+
+    // Keep one byte for the NUL of the current chunk
+    if (out + (i - start) + 1 >= sizeof(data->chunks))
+      break;
+
+    if (width > 0 && width + letter_w > max_w &&
+        data->chunk_count < ADDRESS_MAX_CHUNKS) {
+      data->chunks[out++] = '\0';
+      data->chunk_offset[data->chunk_count++] = out;
+      width = 0;
+    }
+
+    memcpy(&data->chunks[out], &address[start], i - start);
+    out += i - start;
+    width += letter_w;
+  }
+  data->chunks[out] = '\0';
+}
+
 void address_scr_init(const char text[],
                       const char address[],
                       const bool hide_buttons) {
@@ -92,13 +152,25 @@ void address_scr_init(const char text[],
 
   lv_obj_clean(lv_scr_act());
 
-  data = malloc(sizeof(struct Address_Data));
-  obj = malloc(sizeof(struct Address_Object));
+  data = &address_data;
+  obj = &address_obj;
 
-  if (data != NULL) {
-    snprintf(data->text, sizeof(data->text), "%s", text);
-    snprintf(data->address, sizeof(data->address), "%s", address);
-  }
+  snprintf(data->text, sizeof(data->text), "%s", text);
+
+  obj->address = lv_label_create(lv_scr_act(), NULL);
+
+  const lv_style_t *style = lv_obj_get_style(obj->address);
+  lv_coord_t width = lv_txt_get_width(address,
+                                      strnlen(address, ADDRESS_MAX_LEN),
+                                      style->text.font,
+                                      style->text.letter_space,
+                                      LV_TXT_FLAG_NONE);
+
+  split_address(address,
+                style,
+                (width <= ADDRESS_FULL_WIDTH) ? ADDRESS_FULL_WIDTH
+                                              : ADDRESS_CHUNK_WIDTH);
+  data->chunk_index = 0;
 
 #ifdef DEV_BUILD
   address_scr_create(false);
@@ -126,15 +198,81 @@ void address_scr_init(const char text[],
 static void address_scr_destructor() {
   if (data != NULL) {
     memzero(data, sizeof(struct Address_Data));
-    free(data);
     data = NULL;
   }
   if (obj != NULL) {
-    free(obj);
+    memzero(obj, sizeof(struct Address_Object));
     obj = NULL;
   }
 }
 
+/**
+ * @brief Show the arrows for the chunks before and after the current one
+ * @details
+ *
+ * @param
+ *
+ * @return
+ * @retval
+ *
+ * @see
+ * @since v1.0.0
+ *
+ * @note
+ */
+static void change_arrows() {
+  ASSERT(data != NULL);
+  ASSERT(obj != NULL);
+
+  lv_obj_set_hidden(obj->up_arrow, data->chunk_index == 0);
+  lv_obj_set_hidden(obj->down_arrow,
+                    data->chunk_index >= (data->chunk_count - 1));
+}
+
+/**
+ * @brief Show the previous or next chunk of the address on up or down press.
+ * @details Chunks are split beforehand, so this only points the label at
+ * another chunk. The buttons are revealed once the last chunk is shown.
+ *
+ * @param PRESSED_KEY Current key pressed
+ *
+ * @return bool Indicating if the key was consumed
+ * @retval
+ *
+ * @see
+ * @since v1.0.0
+ *
+ * @note
+ */
+static bool change_current_chunk(const lv_key_t PRESSED_KEY) {
+  ASSERT(data != NULL);
+  ASSERT(obj != NULL);
+
+  switch (PRESSED_KEY) {
+    case LV_KEY_DOWN:
+      if (data->chunk_index < (data->chunk_count - 1)) {
+        data->chunk_index++;
+      }
+      break;
+    case LV_KEY_UP:
+      if (data->chunk_index > 0) {
+        data->chunk_index--;
+      }
+      break;
+    default:
+      return false;
+  }
+
+  lv_label_set_static_text(obj->address,
+                           &data->chunks[data->chunk_offset[data->chunk_index]]);
+  change_arrows();
+  if (data->chunk_index >= (data->chunk_count - 1)) {
+    lv_obj_set_hidden(obj->cancel_btn, false);
+    lv_obj_set_hidden(obj->next_btn, false);
+  }
+  return true;
+}
+
 /**
  * @brief Cancel button event handler.
  * @details
@@ -152,6 +290,12 @@ static void address_scr_destructor() {
  */
 static void cancel_btn_event_handler(lv_obj_t *cancel_btn,
                                      const lv_event_t event) {
+  // Chunks can be viewed while the buttons are still hidden
+  if ((LV_EVENT_KEY == event) &&
+      change_current_chunk(lv_indev_get_key(ui_get_indev()))) {
+    return;
+  }
+
   if ((LV_EVENT_DELETE != event) && (lv_obj_get_hidden(cancel_btn))) {
     return;
   }
@@ -200,6 +344,12 @@ static void cancel_btn_event_handler(lv_obj_t *cancel_btn,
  * @note
  */
 static void next_btn_event_handler(lv_obj_t *next_btn, const lv_event_t event) {
+  // Chunks can be viewed while the buttons are still hidden
+  if ((LV_EVENT_KEY == event) &&
+      change_current_chunk(lv_indev_get_key(ui_get_indev()))) {
+    return;
+  }
+
   if ((LV_EVENT_DELETE != event) && (lv_obj_get_hidden(next_btn))) {
     return;
   }
@@ -234,105 +384,42 @@ static void next_btn_event_handler(lv_obj_t *next_btn, const lv_event_t event) {
   }
 }
 
-/**
- * @brief Callback function called after timeout for hidden buttons.
- * @details
- *
- * @param
- *
- * @return
- * @retval
- *
- * @see
- * @since v1.0.0
- *
- * @note
- */
-static void address_timeout_listener(lv_task_t *task) {
-  lv_obj_set_hidden(obj->cancel_btn, false);
-  lv_obj_set_hidden(obj->next_btn, false);
-  lv_task_del(address_timeout_task);
-  address_timeout_task = NULL;
-}
-
-/**
- * @brief Helper function to calculate time for which the buttons should be
- * hidden.
- * @details
- *
- * @param
- *
- * @return uint32_t Time in ms.
- * @retval
- *
- * @see
- * @since v1.0.0
- *
- * @note
- */
-static uint32_t compute_address_timeout() {
-  ASSERT(data != NULL);
-  ASSERT(obj != NULL);
-
-  lv_label_ext_t *ext = lv_obj_get_ext_attr(obj->address);
-  const lv_style_t *style = lv_obj_get_style(obj->address);
-  const lv_font_t *font = style->text.font;
-  lv_coord_t max_w = lv_obj_get_width(obj->address);
-  lv_txt_flag_t flag = LV_TXT_FLAG_EXPAND;
-
-  lv_point_t size;
-  lv_txt_get_size(&size,
-                  ext->text,
-                  font,
-                  style->text.letter_space,
-                  style->text.line_space,
-                  max_w,
-                  flag);
-
-  int32_t diff = size.x - max_w;
-
-  if (diff < 0)
-    return 0;
-
-  uint32_t time = (int32_t)((int32_t)(diff * 1000) / ext->anim_speed);
-
-  if (time > UINT16_MAX)
-    time = UINT16_MAX;
-
-  if (time == 0)
-    time++;
-
-  return time;
-}
-
 void address_scr_create(const bool hidden_buttons) {
   ASSERT(data != NULL);
   ASSERT(obj != NULL);
 
+  bool chunked = (data->chunk_count > 1);
+
   obj->heading = lv_label_create(lv_scr_act(), NULL);
-  obj->address = lv_label_create(lv_scr_act(), NULL);
+  obj->up_arrow = lv_label_create(lv_scr_act(), NULL);
+  obj->down_arrow = lv_label_create(lv_scr_act(), NULL);
   obj->cancel_btn = lv_btn_create(lv_scr_act(), NULL);
   obj->next_btn = lv_btn_create(lv_scr_act(), NULL);
 
   ui_paragraph(obj->heading, data->text, LV_LABEL_ALIGN_CENTER);
-  ui_heading(
-      obj->address, data->address, LV_HOR_RES - 4, LV_LABEL_ALIGN_CENTER);
-  ui_cancel_btn(obj->cancel_btn, cancel_btn_event_handler, hidden_buttons);
-  ui_next_btn(obj->next_btn, next_btn_event_handler, hidden_buttons);
+
+  // Each chunk fits the label, so it is never scrolled nor re-laid out
+  lv_label_set_long_mode(obj->address, LV_LABEL_LONG_CROP);
+  lv_obj_set_width(obj->address,
+                   chunked ? ADDRESS_CHUNK_WIDTH : ADDRESS_FULL_WIDTH);
+  lv_label_set_align(obj->address, LV_LABEL_ALIGN_CENTER);
+  lv_label_set_static_text(obj->address, &data->chunks[0]);
+
+  // Buttons are hidden only until the last chunk has been shown
+  ui_cancel_btn(
+      obj->cancel_btn, cancel_btn_event_handler, hidden_buttons && chunked);
+  ui_next_btn(obj->next_btn, next_btn_event_handler, hidden_buttons && chunked);
 
   lv_obj_align_origo(
       obj->address, obj->heading, LV_ALIGN_OUT_BOTTOM_MID, 0, 12);
-  lv_group_focus_obj(obj->next_btn);
 
-  if (hidden_buttons == true) {
-    uint32_t time = compute_address_timeout();
+  lv_label_set_text(obj->up_arrow, LV_SYMBOL_UP);
+  lv_obj_align(obj->up_arrow, obj->address, LV_ALIGN_OUT_LEFT_MID, -1, 0);
+  lv_label_set_text(obj->down_arrow, LV_SYMBOL_DOWN);
+  lv_obj_align(obj->down_arrow, obj->address, LV_ALIGN_OUT_RIGHT_MID, 1, 0);
+  change_arrows();
 
-    if (time != 0) {
-      address_timeout_task = lv_task_create(
-          address_timeout_listener, time, LV_TASK_PRIO_HIGH, NULL);
-      lv_task_once(address_timeout_task);
-    }
-  }
+  lv_group_focus_obj(obj->next_btn);
 }
 
 void address_scr_focus_cancel() {
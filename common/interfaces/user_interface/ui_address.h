@@ -13,9 +13,14 @@
 
 #include "ui_common.h"
 
+#define ADDRESS_MAX_LEN 512
+#define ADDRESS_MAX_CHUNKS 64
+
 /**
  * @brief struct to store address and heading
- * @details
+ * @details The address is split once into chunks fitting the display width.
+ * The chunks are stored back to back, each NUL terminated, so that showing
+ * another chunk only points the label at a different offset.
  *
  * @see
  * @since v1.0.0
@@ -24,7 +29,10 @@
  */
 struct Address_Data {
   char text[512];
-  char address[512];
+  char chunks[ADDRESS_MAX_LEN + ADDRESS_MAX_CHUNKS];
+  uint16_t chunk_offset[ADDRESS_MAX_CHUNKS];
+  uint8_t chunk_count;
+  uint8_t chunk_index;
 };
 
 /**
@@ -39,17 +47,21 @@ struct Address_Data {
 struct Address_Object {
   lv_obj_t *heading;
   lv_obj_t *address;
+  lv_obj_t *up_arrow;
+  lv_obj_t *down_arrow;
   lv_obj_t *cancel_btn;
   lv_obj_t *next_btn;
 };
 
 /**
  * @brief Initialize and create an address screen
- * @details
+ * @details An address wider than the display is shown one chunk at a time;
+ * the joystick up and down keys move to the previous and next chunk.
  *
  * @param text Heading
  * @param address Address
- * @param hide_buttons hide the next and cancel buttons
+ * @param hide_buttons hide the next and cancel buttons until the last chunk of
+ * the address has been shown
  *
  * @return
  * @retval
@@ -63,6 +63,8 @@
 
 #include "ui_events_priv.h"
 
+static struct List_Data list_data;
+static struct List_Object list_obj;
 static struct List_Data *data = NULL;
 static struct List_Object *obj = NULL;
 
@@ -81,9 +83,8 @@ void list_init(const char option_list[MAX_UI_LIST_WORDS][MAX_UI_LIST_CHAR_LEN],
 
   lv_obj_clean(lv_scr_act());
 
-  data = malloc(sizeof(struct List_Data));
-  obj = malloc(sizeof(struct List_Object));
-  ASSERT(data != NULL && obj != NULL);
+  data = &list_data;
+  obj = &list_obj;
 
   if (data != NULL) {
     data->number_of_options = number_of_options;
@@ -119,11 +120,10 @@ void list_init(const char option_list[MAX_UI_LIST_WORDS][MAX_UI_LIST_CHAR_LEN],
 static void list_destructor() {
   if (data != NULL) {
     memzero(data, sizeof(struct List_Data));
-    free(data);
     data = NULL;
   }
   if (obj != NULL) {
-    free(obj);
+    memzero(obj, sizeof(struct List_Object));
     obj = NULL;
   }
 }
@@ -200,6 +200,30 @@ static void change_arrows() {
   }
 }
 
+/**
+ * @brief Write the number of the current option after the heading prefix
+ * @details Only the index changes between options, so the prefix is written
+ * once in list_create() and the label keeps pointing at the same buffer.
+ *
+ * @param
+ *
+ * @return
+ * @retval
+ *
+ * @see
+ * @since v1.0.0
+ *
+ * @note
+ */
+static void set_heading_index() {
+  ASSERT(data != NULL);
+
+  snprintf(&data->heading_text[data->heading_prefix_len],
+           sizeof(data->heading_text) - data->heading_prefix_len,
+           "%d",
+           data->current_index + 1);
+}
+
 /**
  * @brief Update the heading the of the list UI
  * @details
@@ -218,10 +242,8 @@ static void change_heading() {
   ASSERT(data != NULL);
   ASSERT(obj != NULL);
 
-  char buffer[36];    // TODO : Add Constant
-  snprintf(
-      buffer, sizeof(buffer), "%s%d", data->heading, data->current_index + 1);
-  lv_label_set_text(obj->heading, buffer);
+  set_heading_index();
+  lv_label_set_static_text(obj->heading, data->heading_text);
 }
 
 /**
@@ -390,13 +412,12 @@ void list_create() {
   ASSERT(data != NULL);
   ASSERT(obj != NULL);
 
-  char buffer[36] = {0};
-
+  snprintf(
+      data->heading_text, sizeof(data->heading_text), "%s", data->heading);
+  data->heading_prefix_len = strnlen(data->heading_text,
+                                     sizeof(data->heading_text) - 1);
   if (data->dynamic_heading == true) {
-    snprintf(
-        buffer, sizeof(buffer), "%s%d", data->heading, data->current_index + 1);
-  } else {
-    strcpy(buffer, data->heading);
+    set_heading_index();
   }
 
   obj->heading = lv_label_create(lv_scr_act(), NULL);
@@ -406,7 +427,10 @@ void list_create() {
   obj->back_btn = lv_btn_create(lv_scr_act(), NULL);
   obj->next_btn = lv_btn_create(lv_scr_act(), NULL);
 
-  ui_heading(obj->heading, buffer, LV_HOR_RES - 20, LV_LABEL_ALIGN_CENTER);
+  ui_heading(obj->heading,
+             data->heading_text,
+             LV_HOR_RES - 20,
+             LV_LABEL_ALIGN_CENTER);
   ui_options(obj->options,
              options_event_handler,
              obj->right_arrow,
@@ -18,6 +18,7 @@
 #define MAX_UI_LIST_CHAR_LEN MAX_MNEMONIC_WORD_LENGTH
 
 // TODO: Update count for higher coin list
+#define MAX_UI_LIST_HEADING_LEN 36
 
 /**
  * @brief struct to store list data
@@ -34,6 +35,8 @@ struct List_Data {
   int current_index;
   bool dynamic_heading;
   char *heading;
+  char heading_text[MAX_UI_LIST_HEADING_LEN]; /**< Shown heading */
+  uint8_t heading_prefix_len; /**< Length of heading within heading_text */
 };
 
 /**
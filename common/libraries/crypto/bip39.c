@@ -179,10 +179,10 @@ int mnemonic_check(const char *mnemonic) {
 }
 
 // passphrase must be at most 256 characters otherwise it would be truncated
-void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
-                      uint8_t seed[512 / 8],
-                      void (*progress_callback)(uint32_t current,
-                                                uint32_t total)) {
+static int mnemonic_to_seed_internal(
+    const char *mnemonic, const char *passphrase, uint8_t seed[512 / 8],
+    void (*progress_callback)(uint32_t current, uint32_t total),
+    bool (*yield_callback)(uint32_t current, uint32_t total)) {
   int mnemoniclen = strlen(mnemonic);
   int passphraselen = strnlen(passphrase, 256);
 #if USE_BIP39_CACHE
@@ -194,7 +194,7 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
       if (strcmp(bip39_cache[i].passphrase, passphrase) != 0) continue;
       // found the correct entry
       memcpy(seed, bip39_cache[i].seed, 512 / 8);
-      return;
+      return 1;
     }
   }
 #endif
@@ -204,18 +204,27 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
   static CONFIDENTIAL PBKDF2_HMAC_SHA512_CTX pctx;
   pbkdf2_hmac_sha512_Init(&pctx, (const uint8_t *)mnemonic, mnemoniclen, salt,
                           passphraselen + 8, 1);
+  memzero(salt, sizeof(salt));
   if (progress_callback) {
     progress_callback(0, BIP39_PBKDF2_ROUNDS);
   }
-  for (int i = 0; i < 16; i++) {
-    pbkdf2_hmac_sha512_Update(&pctx, BIP39_PBKDF2_ROUNDS / 16);
+  if (yield_callback && !yield_callback(0, BIP39_PBKDF2_ROUNDS)) {
+    memzero(&pctx, sizeof(pctx));
+    return 0;
+  }
+  for (int i = 0; i < BIP39_PBKDF2_YIELD_STEPS; i++) {
+    pbkdf2_hmac_sha512_Update(&pctx,
+                              BIP39_PBKDF2_ROUNDS / BIP39_PBKDF2_YIELD_STEPS);
+    uint32_t done = (i + 1) * BIP39_PBKDF2_ROUNDS / BIP39_PBKDF2_YIELD_STEPS;
     if (progress_callback) {
-      progress_callback((i + 1) * BIP39_PBKDF2_ROUNDS / 16,
-                        BIP39_PBKDF2_ROUNDS);
+      progress_callback(done, BIP39_PBKDF2_ROUNDS);
+    }
+    if (yield_callback && !yield_callback(done, BIP39_PBKDF2_ROUNDS)) {
+      memzero(&pctx, sizeof(pctx));
+      return 0;
     }
   }
   pbkdf2_hmac_sha512_Final(&pctx, seed);
-  memzero(salt, sizeof(salt));
 #if USE_BIP39_CACHE
   // store to cache
   if (mnemoniclen < 256 && passphraselen < 64) {
@@ -226,6 +235,23 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
     bip39_cache_index = (bip39_cache_index + 1) % BIP39_CACHE_SIZE;
   }
 #endif
+  return 1;
+}
+
+void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
+                      uint8_t seed[512 / 8],
+                      void (*progress_callback)(uint32_t current,
+                                                uint32_t total)) {
+  mnemonic_to_seed_internal(mnemonic, passphrase, seed, progress_callback,
+                            NULL);
+}
+
+int mnemonic_to_seed_yield(const char *mnemonic, const char *passphrase,
+                           uint8_t seed[512 / 8],
+                           bool (*yield_callback)(uint32_t current,
+                                                  uint32_t total)) {
+  return mnemonic_to_seed_internal(mnemonic, passphrase, seed, NULL,
+                                   yield_callback);
 }
 
 // binary search for finding the word in the wordlist
@@ -29,6 +29,8 @@
 
 #define BIP39_WORDS 2048
 #define BIP39_PBKDF2_ROUNDS 2048
+// number of chunks the PBKDF2 rounds are split into between callbacks
+#define BIP39_PBKDF2_YIELD_STEPS 64
 
 const char* mnemonic_generate(int strength); // strength in bits
 const char* mnemonic_from_data(const uint8_t* data, int len);
@@ -44,6 +46,13 @@ void mnemonic_to_seed(const char* mnemonic, const char* passphrase,
     void (*progress_callback)(uint32_t current,
         uint32_t total));
 
+// same as mnemonic_to_seed, but the derivation is abandoned as soon as
+// yield_callback returns false; returns 0 in that case and 1 on success
+int mnemonic_to_seed_yield(const char* mnemonic, const char* passphrase,
+    uint8_t seed[512 / 8],
+    bool (*yield_callback)(uint32_t current,
+        uint32_t total));
+
 int mnemonic_find_word(const char* word);
 const char* mnemonic_complete_word(const char* prefix, int len);
 const char* mnemonic_get_word(int index);
@@ -667,15 +667,11 @@ int ecdsa_sign(const ecdsa_curve *curve, HasherType hasher_sign,
   return res;
 }
 
-// uses secp256k1 curve
-// priv_key is a 32 byte big endian stored number
-// sig is 64 bytes long array for the signature
-// digest is 32 bytes of digest
-// is_canonical is an optional function that checks if the signature
-// conforms to additional coin-specific rules.
-int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
-                      const uint8_t *digest, uint8_t *sig, uint8_t *pby,
-                      int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
+// key is the prepared rfc6979 state of priv_key or NULL
+static int sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
+                       const rfc6979_key_state *key, const uint8_t *digest,
+                       uint8_t *sig, uint8_t *pby,
+                       int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
   int i = 0;
   curve_point R = {0};
   bignum256 k = {0}, z = {0}, randk = {0};
@@ -684,7 +680,13 @@ int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
 
 #if USE_RFC6979
   rfc6979_state rng = {0};
-  init_rfc6979(priv_key, digest, &rng);
+  if (key) {
+    init_rfc6979_prepared(key, digest, &rng);
+  } else {
+    init_rfc6979(priv_key, digest, &rng);
+  }
+#else
+  (void)key;
 #endif
 
   bn_read_be(digest, &z);
@@ -766,6 +768,30 @@ int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
   return -1;
 }
 
+// uses secp256k1 curve
+// priv_key is a 32 byte big endian stored number
+// sig is 64 bytes long array for the signature
+// digest is 32 bytes of digest
+// is_canonical is an optional function that checks if the signature
+// conforms to additional coin-specific rules.
+int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
+                      const uint8_t *digest, uint8_t *sig, uint8_t *pby,
+                      int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
+  return sign_digest(curve, priv_key, NULL, digest, sig, pby, is_canonical);
+}
+
+// same as ecdsa_sign_digest with the key dependent part of the rfc6979
+// nonce generation done once by init_rfc6979_key
+int ecdsa_sign_digest_prepared(const ecdsa_curve *curve,
+                               const rfc6979_key_state *key,
+                               const uint8_t *digest, uint8_t *sig,
+                               uint8_t *pby,
+                               int (*is_canonical)(uint8_t by,
+                                                   uint8_t sig[64])) {
+  return sign_digest(curve, key->priv_key, key, digest, sig, pby,
+                     is_canonical);
+}
+
 void ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key,
                             uint8_t *pub_key) {
   curve_point R = {0};
@@ -1086,6 +1112,212 @@ int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
   return result;
 }
 
+// converts n jacobian points to affine with a single field inversion
+static void jacobian_to_curve_batch(const jacobian_curve_point *jp,
+                                    curve_point *p, int n,
+                                    const bignum256 *prime) {
+  bignum256 inv = {0}, zinv = {0};
+
+  // p[i].x = z[0] * ... * z[i]
+  p[0].x = jp[0].z;
+  for (int i = 1; i < n; i++) {
+    p[i].x = jp[i].z;
+    bn_multiply(&p[i - 1].x, &p[i].x, prime);
+  }
+  inv = p[n - 1].x;
+  bn_inverse(&inv, prime);
+
+  for (int i = n - 1; i >= 0; i--) {
+    // zinv = z[i]^-1, inv = (z[0] * ... * z[i-1])^-1
+    zinv = inv;
+    if (i > 0) {
+      bn_multiply(&p[i - 1].x, &zinv, prime);
+      bn_multiply(&jp[i].z, &inv, prime);
+    }
+    p[i].y = zinv;
+    bn_multiply(&zinv, &zinv, prime);
+    // zinv = z^-2
+    bn_multiply(&zinv, &p[i].y, prime);
+    // p->y = z^-3
+    p[i].x = jp[i].x;
+    bn_multiply(&zinv, &p[i].x, prime);
+    bn_multiply(&jp[i].y, &p[i].y, prime);
+    bn_mod(&p[i].x, prime);
+    bn_mod(&p[i].y, prime);
+  }
+  memzero(&inv, sizeof(inv));
+  memzero(&zinv, sizeof(zinv));
+}
+
+// returns 0 if the table was built for pub_key
+int ecdsa_pubkey_table_init(const ecdsa_curve *curve, const uint8_t *pub_key,
+                            ecdsa_pubkey_table *table) {
+  const bignum256 *prime = &curve->prime;
+  jacobian_curve_point jp[8] = {0};
+  curve_point base = {0}, pair[2] = {0};
+
+  if (!ecdsa_read_pubkey(curve, pub_key, &base)) {
+    return 1;
+  }
+
+  for (int i = 0; i < ECDSA_PUBKEY_TABLE_ROWS; i++) {
+    // jp[0] = 2^(32*i) * pub, jp[1] = 2 * jp[0]
+    curve_to_jacobian(&base, &jp[0], prime);
+    if (i > 0) {
+      for (int j = 0; j < 32; j++) {
+        point_jacobian_double(&jp[0], curve);
+      }
+    }
+    jp[1] = jp[0];
+    point_jacobian_double(&jp[1], curve);
+    jacobian_to_curve_batch(jp, pair, 2, prime);
+
+    // cp[i][j] = cp[i][j-1] + 2 * cp[i][0]
+    table->cp[i][0] = pair[0];
+    curve_to_jacobian(&pair[0], &jp[0], prime);
+    for (int j = 1; j < 8; j++) {
+      jp[j] = jp[j - 1];
+      point_jacobian_add(&pair[1], &jp[j], curve);
+    }
+    jacobian_to_curve_batch(&jp[1], &table->cp[i][1], 7, prime);
+    base = pair[0];
+  }
+
+  memzero(jp, sizeof(jp));
+  return 0;
+}
+
+// res = k * pub using the table of pub, returns 0 on success. The caller
+// falls back to point_multiply when the comb hits the point at infinity.
+STATIC int pubkey_table_multiply(const ecdsa_curve *curve,
+                                 const ecdsa_pubkey_table *table,
+                                 const bignum256 *k, curve_point *res) {
+  assert(bn_is_less(k, &curve->order));
+
+  const bignum256 *prime = &curve->prime;
+  uint32_t is_even = (k->val[0] & 1) - 1;
+  uint32_t is_non_zero = 0;
+  int8_t digits[64] = {0};
+  jacobian_curve_point jres = {0};
+  curve_point term = {0};
+  bignum256 a = {0};
+  int started = 0;
+
+  // a = k + 2^256 (mod curve->order), made odd as in point_multiply
+  uint32_t tmp = 1;
+  int j = 0;
+  for (j = 0; j < 8; j++) {
+    is_non_zero |= k->val[j];
+    tmp += 0x3fffffff + k->val[j] - (curve->order.val[j] & is_even);
+    a.val[j] = tmp & 0x3fffffff;
+    tmp >>= 30;
+  }
+  is_non_zero |= k->val[j];
+  a.val[j] = tmp + 0xffff + k->val[j] - (curve->order.val[j] & is_even);
+
+  if (!is_non_zero) {
+    point_set_infinity(res);
+    return 0;
+  }
+
+  // k * pub = sum_{i=0..63} digits[i] 16^i * pub with odd |digits[i]| < 16
+  for (int i = 0; i < 64; i++) {
+    int pos = 4 * i, limb = pos / 30, shift = pos % 30;
+    uint32_t bits = a.val[limb] >> shift;
+    if (shift > 25) {
+      bits |= a.val[limb + 1] << (30 - shift);
+    }
+    bits &= 31;
+    digits[i] = (bits & 16) ? (int8_t)((bits & 15) | 1)
+                            : (int8_t)-((15 - (bits & 15)) | 1);
+  }
+
+  // digit 8*row + m is multiplied by 16^m * 2^(32*row) * pub; process the
+  // nibble position m from the top with 4 doublings in between
+  for (int m = 7; m >= 0; m--) {
+    if (started) {
+      point_jacobian_double(&jres, curve);
+      point_jacobian_double(&jres, curve);
+      point_jacobian_double(&jres, curve);
+      point_jacobian_double(&jres, curve);
+    }
+    for (int row = 0; row < ECDSA_PUBKEY_TABLE_ROWS; row++) {
+      int8_t digit = digits[8 * row + m];
+      term = table->cp[row][(digit < 0 ? -digit : digit) >> 1];
+      if (digit < 0) {
+        bn_subtract(prime, &term.y, &term.y);
+      }
+      if (!started) {
+        curve_to_jacobian(&term, &jres, prime);
+        started = 1;
+      } else {
+        point_jacobian_add(&term, &jres, curve);
+      }
+    }
+  }
+
+  // z == 0 (mod prime) means an intermediate sum was the point at infinity
+  bn_mod(&jres.z, prime);
+  if (bn_is_zero(&jres.z)) {
+    return 1;
+  }
+  jacobian_to_curve(&jres, res, prime);
+  memzero(&a, sizeof(a));
+  return 0;
+}
+
+// same as ecdsa_verify_digest with the public key given by its table,
+// returns 0 if verification succeeded
+int ecdsa_verify_digest_table(const ecdsa_curve *curve,
+                              const ecdsa_pubkey_table *table,
+                              const uint8_t *sig, const uint8_t *digest) {
+  curve_point pub = {0}, res = {0};
+  bignum256 r = {0}, s = {0}, z = {0};
+
+  bn_read_be(sig, &r);
+  bn_read_be(sig + 32, &s);
+
+  bn_read_be(digest, &z);
+
+  if (bn_is_zero(&r) || bn_is_zero(&s) || (!bn_is_less(&r, &curve->order)) ||
+      (!bn_is_less(&s, &curve->order)))
+    return 2;
+
+  bn_inverse(&s, &curve->order);       // s^-1
+  bn_multiply(&s, &z, &curve->order);  // z*s^-1
+  bn_mod(&z, &curve->order);
+  bn_multiply(&r, &s, &curve->order);  // r*s^-1
+  bn_mod(&s, &curve->order);
+
+  int result = 0;
+  if (bn_is_zero(&z)) {
+    result = 3;
+  } else {
+    scalar_multiply(curve, &z, &res);
+  }
+
+  if (result == 0) {
+    if (0 != pubkey_table_multiply(curve, table, &s, &pub)) {
+      // cp[0][0] is the public key itself
+      point_multiply(curve, &s, &table->cp[0][0], &pub);
+    }
+    point_add(curve, &pub, &res);
+    bn_mod(&(res.x), &curve->order);
+    // signature does not match
+    if (!bn_is_equal(&res.x, &r)) {
+      result = 5;
+    }
+  }
+
+  memzero(&pub, sizeof(pub));
+  memzero(&res, sizeof(res));
+  memzero(&r, sizeof(r));
+  memzero(&s, sizeof(s));
+  memzero(&z, sizeof(z));
+
+  return result;
+}
+
 int ecdsa_sig_to_der(const uint8_t *sig, uint8_t *der) {
   int i = 0;
   uint8_t *p = der, *len = NULL, *len1 = NULL, *len2 = NULL;
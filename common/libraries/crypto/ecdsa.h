@@ -28,6 +28,7 @@
 #include "bignum.h"
 #include "hasher.h"
 #include "options.h"
+#include "rfc6979.h"
 
 // curve point x and y
 typedef struct {
@@ -48,6 +49,15 @@ typedef struct {
 
 } ecdsa_curve;
 
+// number of rows of a public key table; row i starts at 2^(32*i) * pub
+#define ECDSA_PUBKEY_TABLE_ROWS 8
+
+// precomputed multiples of a long-lived public key used for verification,
+// cp[i][j] = (2*j+1) * 2^(32*i) * pub
+typedef struct {
+  curve_point cp[ECDSA_PUBKEY_TABLE_ROWS][8];
+} ecdsa_pubkey_table;
+
 // 4 byte prefix + 40 byte data (segwit)
 // 1 byte prefix + 64 byte data (cashaddr)
 #define MAX_ADDR_RAW_SIZE 65
@@ -88,6 +98,12 @@ int ecdsa_sign(const ecdsa_curve *curve, HasherType hasher_sign,
 int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
                       const uint8_t *digest, uint8_t *sig, uint8_t *pby,
                       int (*is_canonical)(uint8_t by, uint8_t sig[64]));
+int ecdsa_sign_digest_prepared(const ecdsa_curve *curve,
+                               const rfc6979_key_state *key,
+                               const uint8_t *digest, uint8_t *sig,
+                               uint8_t *pby,
+                               int (*is_canonical)(uint8_t by,
+                                                   uint8_t sig[64]));
 void ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key,
                             uint8_t *pub_key);
 void ecdsa_get_public_key65(const ecdsa_curve *curve, const uint8_t *priv_key,
@@ -119,6 +135,11 @@ int ecdsa_verify(const ecdsa_curve *curve, HasherType hasher_sign,
                  uint32_t msg_len);
 int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
                         const uint8_t *sig, const uint8_t *digest);
+int ecdsa_pubkey_table_init(const ecdsa_curve *curve, const uint8_t *pub_key,
+                            ecdsa_pubkey_table *table);
+int ecdsa_verify_digest_table(const ecdsa_curve *curve,
+                              const ecdsa_pubkey_table *table,
+                              const uint8_t *sig, const uint8_t *digest);
 int ecdsa_recover_pub_from_sig(const ecdsa_curve *curve, uint8_t *pub_key,
                                const uint8_t *sig, const uint8_t *digest,
                                int recid);
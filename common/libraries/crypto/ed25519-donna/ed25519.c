@@ -40,20 +40,72 @@ ed25519_hram(hash_512bits hram, const ed25519_signature RS, const ed25519_public
 	ed25519_hash_final(&ctx, hram);
 }
 
-void
-ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key pk) {
+static void
+ed25519_publickey_extsk(const hash_512bits extsk, ed25519_public_key pk) {
 	bignum256modm a = {0};
 	ge25519 ALIGN(16) A;
-	hash_512bits extsk = {0};
 
 	/* A = aB */
-	ed25519_extsk(extsk, sk);
-
 	expand256_modm(a, extsk, 32);
 	ge25519_scalarmult_base_niels(&A, ge25519_niels_base_multiples, a);
 	ge25519_pack(pk, &A);
 }
 
+/*
+	Signs with an already expanded secret key; the public key is not checked
+*/
+static void
+ed25519_sign_extsk(const unsigned char *m, size_t mlen, const hash_512bits extsk, const ed25519_public_key pk, ed25519_signature RS) {
+	ed25519_hash_context ctx;
+	bignum256modm r = {0}, S = {0}, a = {0};
+	ge25519 ALIGN(16) R = {0};
+	hash_512bits hashr = {0}, hram = {0};
+
+	/* r = H(aExt[32..64], m) */
+	ed25519_hash_init(&ctx);
+	ed25519_hash_update(&ctx, extsk + 32, 32);
+	ed25519_hash_update(&ctx, m, mlen);
+	ed25519_hash_final(&ctx, hashr);
+	expand256_modm(r, hashr, 64);
+
+	/* R = rB */
+	ge25519_scalarmult_base_niels(&R, ge25519_niels_base_multiples, r);
+	ge25519_pack(RS, &R);
+
+	/* S = H(R,A,m).. */
+	ed25519_hram(hram, RS, pk, m, mlen);
+	expand256_modm(S, hram, 64);
+
+	/* S = H(R,A,m)a */
+	expand256_modm(a, extsk, 32);
+	mul256_modm(S, S, a);
+
+	/* S = (r + H(R,A,m)a) */
+	add256_modm(S, S, r);
+
+	/* S = (r + H(R,A,m)a) mod L */
+	contract256_modm(RS + 32, S);
+}
+
+void
+ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key pk) {
+	hash_512bits extsk = {0};
+
+	ed25519_extsk(extsk, sk);
+	ed25519_publickey_extsk(extsk, pk);
+}
+
+void
+ED25519_FN(ed25519_expand_key) (const ed25519_secret_key sk, ed25519_expanded_key *key) {
+	ed25519_extsk(key->extsk, sk);
+	ed25519_publickey_extsk(key->extsk, key->pk);
+}
+
+void
+ED25519_FN(ed25519_sign_expanded) (const unsigned char *m, size_t mlen, const ed25519_expanded_key *key, ed25519_signature RS) {
+	ed25519_sign_extsk(m, mlen, key->extsk, key->pk, RS);
+}
+
 #if USE_CARDANO
 void
 ED25519_FN(ed25519_publickey_ext) (const ed25519_secret_key sk, const ed25519_secret_key skext, ed25519_public_key pk) {
@@ -99,38 +151,10 @@ ED25519_FN(ed25519_cosi_sign) (const unsigned char *m, size_t mlen, const ed2551
 
 void
 ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS) {
-	ed25519_hash_context ctx;
-	bignum256modm r = {0}, S = {0}, a = {0};
-	ge25519 ALIGN(16) R = {0};
-	hash_512bits extsk = {0}, hashr = {0}, hram = {0};
+	hash_512bits extsk = {0};
 
 	ed25519_extsk(extsk, sk);
-
-
-	/* r = H(aExt[32..64], m) */
-	ed25519_hash_init(&ctx);
-	ed25519_hash_update(&ctx, extsk + 32, 32);
-	ed25519_hash_update(&ctx, m, mlen);
-	ed25519_hash_final(&ctx, hashr);
-	expand256_modm(r, hashr, 64);
-
-	/* R = rB */
-	ge25519_scalarmult_base_niels(&R, ge25519_niels_base_multiples, r);
-	ge25519_pack(RS, &R);
-
-	/* S = H(R,A,m).. */
-	ed25519_hram(hram, RS, pk, m, mlen);
-	expand256_modm(S, hram, 64);
-
-	/* S = H(R,A,m)a */
-	expand256_modm(a, extsk, 32);
-	mul256_modm(S, S, a);
-
-	/* S = (r + H(R,A,m)a) */
-	add256_modm(S, S, r);
-
-	/* S = (r + H(R,A,m)a) mod L */
-	contract256_modm(RS + 32, S);
+	ed25519_sign_extsk(m, mlen, extsk, pk, RS);
 }
 
 #if USE_CARDANO
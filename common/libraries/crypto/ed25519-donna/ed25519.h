@@ -13,6 +13,13 @@ typedef unsigned char ed25519_secret_key[32];
 
 typedef unsigned char curve25519_key[32];
 
+/* Secret key expanded once (clamped scalar || nonce prefix) along with its
+   public key, so that several messages can be signed without redoing either */
+typedef struct {
+	unsigned char extsk[64];
+	ed25519_public_key pk;
+} ed25519_expanded_key;
+
 typedef unsigned char ed25519_cosi_signature[32];
 
 void ed25519_publickey(const ed25519_secret_key sk, ed25519_public_key pk);
@@ -22,6 +29,8 @@ void ed25519_publickey_ext(const ed25519_secret_key sk, const ed25519_secret_key
 
 int ed25519_sign_open(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+void ed25519_expand_key(const ed25519_secret_key sk, ed25519_expanded_key *key);
+void ed25519_sign_expanded(const unsigned char *m, size_t mlen, const ed25519_expanded_key *key, ed25519_signature RS);
 #if USE_CARDANO
 void ed25519_sign_ext(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_secret_key skext, const ed25519_public_key pk, ed25519_signature RS);
 #endif
@@ -141,7 +141,30 @@ void hasher_Raw(HasherType type, const uint8_t *data, size_t length,
                 uint8_t hash[HASHER_DIGEST_LENGTH]) {
   Hasher hasher = {0};
 
+  // single-block fast paths for the short inputs of addresses and checksums
+  if (length <= SHA256_SHORT_MAX_LENGTH) {
+    switch (type) {
+      case HASHER_SHA2:
+        sha256_Raw_short(data, length, hash);
+        return;
+      case HASHER_SHA2D:
+        sha256d_short(data, length, hash);
+        return;
+      case HASHER_SHA2_RIPEMD:
+        sha256_Raw_short(data, length, hash);
+        ripemd160_32(hash, hash);
+        return;
+      default:
+        break;
+    }
+  }
+
   hasher_Init(&hasher, type);
   hasher_Update(&hasher, data, length);
   hasher_Final(&hasher, hash);
 }
+
+void hash160_33(const uint8_t pub_key[33], uint8_t hash[HASHER_DIGEST_LENGTH]) {
+  sha256_33(pub_key, hash);
+  ripemd160_32(hash, hash);
+}
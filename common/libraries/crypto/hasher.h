@@ -79,4 +79,7 @@ void hasher_Final(Hasher *hasher, uint8_t hash[HASHER_DIGEST_LENGTH]);
 void hasher_Raw(HasherType type, const uint8_t *data, size_t length,
                 uint8_t hash[HASHER_DIGEST_LENGTH]);
 
+// RIPEMD-160(SHA-256(pub_key)) of a compressed public key
+void hash160_33(const uint8_t pub_key[33], uint8_t hash[HASHER_DIGEST_LENGTH]);
+
 #endif
@@ -25,6 +25,8 @@
 #include "memzero.h"
 #include "sha2.h"
 
+static void finish_k(HMAC_DRBG_CTX *ctx, uint32_t *h);
+
 static void update_k(HMAC_DRBG_CTX *ctx, uint8_t domain, const uint8_t *data1,
                      size_t len1, const uint8_t *data2, size_t len2) {
   // Computes K = HMAC(K, V || domain || data1 || data 2).
@@ -58,6 +60,13 @@ static void update_k(HMAC_DRBG_CTX *ctx, uint8_t domain, const uint8_t *data1,
 #endif
   }
 
+  finish_k(ctx, h);
+}
+
+static void finish_k(HMAC_DRBG_CTX *ctx, uint32_t *h) {
+  // Completes K = HMAC(K, ...) from the first hash in h and precomputes the
+  // inner and outer digests of the new K. h is cleared.
+
   // Second hash operation of HMAC.
   h[8] = 0x80000000;
   h[15] = (SHA256_BLOCK_LENGTH + SHA256_DIGEST_LENGTH) * 8;
@@ -75,7 +84,7 @@ static void update_k(HMAC_DRBG_CTX *ctx, uint8_t domain, const uint8_t *data1,
     h[i] = h[i] ^ 0x36363636 ^ 0x5c5c5c5c;
   }
   sha256_Transform(sha256_initial_hash_value, h, ctx->odig);
-  memzero(h, sizeof(h));
+  memzero(h, SHA256_BLOCK_LENGTH);
 }
 
 static void update_v(HMAC_DRBG_CTX *ctx) {
@@ -105,6 +114,59 @@ void hmac_drbg_init(HMAC_DRBG_CTX *ctx, const uint8_t *entropy,
   memzero(h, sizeof(h));
 }
 
+void hmac_drbg_prepare(HMAC_DRBG_PREPARED *prep, const uint8_t *entropy,
+                       size_t entropy_len) {
+  uint32_t h[SHA256_BLOCK_LENGTH / sizeof(uint32_t)] = {0};
+  uint8_t v[SHA256_DIGEST_LENGTH] = {0};
+  uint8_t domain = 0;
+
+  // Start the inner hash of HMAC with K = 0x00 ... 0x00 and absorb
+  // V = 0x01 ... 0x01, the domain and the entropy.
+  sha256_Init(&prep->inner);
+  memset(h, 0x36, sizeof(h));
+  sha256_Transform(sha256_initial_hash_value, h, prep->inner.state);
+  prep->inner.bitcount = SHA256_BLOCK_LENGTH * 8;
+  memset(v, 1, sizeof(v));
+  sha256_Update(&prep->inner, v, sizeof(v));
+  sha256_Update(&prep->inner, &domain, 1);
+  sha256_Update(&prep->inner, entropy, entropy_len);
+
+  memset(h, 0x5c, sizeof(h));
+  sha256_Transform(sha256_initial_hash_value, h, prep->odig);
+
+  memzero(h, sizeof(h));
+}
+
+void hmac_drbg_init_prepared(HMAC_DRBG_CTX *ctx,
+                             const HMAC_DRBG_PREPARED *prep,
+                             const uint8_t *entropy, size_t entropy_len,
+                             const uint8_t *nonce, size_t nonce_len) {
+  uint32_t h[SHA256_BLOCK_LENGTH / sizeof(uint32_t)] = {0};
+  SHA256_CTX sha_ctx = {0};
+
+  // Same as hmac_drbg_init() with the first K = HMAC(K, V || 0x00 || entropy
+  // || nonce) resumed from the prepared inner hash.
+  memcpy(&sha_ctx, &prep->inner, sizeof(sha_ctx));
+  sha256_Update(&sha_ctx, nonce, nonce_len);
+  sha256_Final(&sha_ctx, (uint8_t *)h);
+#if BYTE_ORDER == LITTLE_ENDIAN
+  for (size_t i = 0; i < SHA256_DIGEST_LENGTH / sizeof(uint32_t); i++)
+    REVERSE32(h[i], h[i]);
+#endif
+  memcpy(ctx->odig, prep->odig, SHA256_DIGEST_LENGTH);
+  finish_k(ctx, h);
+
+  memset(ctx->v, 1, SHA256_DIGEST_LENGTH);
+  for (size_t i = 9; i < 15; i++) ctx->v[i] = 0;
+  ctx->v[8] = 0x80000000;
+  ctx->v[15] = (SHA256_BLOCK_LENGTH + SHA256_DIGEST_LENGTH) * 8;
+  update_v(ctx);
+
+  if (entropy_len == 0) return;
+  update_k(ctx, 1, entropy, entropy_len, nonce, nonce_len);
+  update_v(ctx);
+}
+
 void hmac_drbg_reseed(HMAC_DRBG_CTX *ctx, const uint8_t *entropy, size_t len,
                       const uint8_t *addin, size_t addin_len) {
   update_k(ctx, 0, entropy, len, addin, addin_len);
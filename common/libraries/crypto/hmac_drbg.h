@@ -34,8 +34,23 @@ typedef struct _HMAC_DRBG_CTX {
   uint32_t v[SHA256_BLOCK_LENGTH / sizeof(uint32_t)];
 } HMAC_DRBG_CTX;
 
+// Part of the instantiation that only depends on the entropy input, so that
+// generators sharing the entropy (e.g. a signing key) and differing in the
+// nonce can be instantiated without hashing the entropy again.
+typedef struct _HMAC_DRBG_PREPARED {
+  // inner hash of HMAC(0x00..00, 0x01..01 || 0x00 || entropy)
+  SHA256_CTX inner;
+  uint32_t odig[SHA256_DIGEST_LENGTH / sizeof(uint32_t)];
+} HMAC_DRBG_PREPARED;
+
 void hmac_drbg_init(HMAC_DRBG_CTX *ctx, const uint8_t *buf, size_t len,
                     const uint8_t *nonce, size_t nonce_len);
+void hmac_drbg_prepare(HMAC_DRBG_PREPARED *prep, const uint8_t *entropy,
+                       size_t entropy_len);
+void hmac_drbg_init_prepared(HMAC_DRBG_CTX *ctx,
+                             const HMAC_DRBG_PREPARED *prep,
+                             const uint8_t *entropy, size_t entropy_len,
+                             const uint8_t *nonce, size_t nonce_len);
 void hmac_drbg_reseed(HMAC_DRBG_CTX *ctx, const uint8_t *buf, size_t len,
                       const uint8_t *addin, size_t addin_len);
 void hmac_drbg_generate(HMAC_DRBG_CTX *ctx, uint8_t *buf, size_t len);
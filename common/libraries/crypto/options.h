@@ -91,6 +91,16 @@
 #define USE_KECCAK 1
 #endif
 
+// compute SHA-512 on 32-bit halves; faster on targets without 64-bit ALU
+#ifndef USE_SHA512_32BIT
+#define USE_SHA512_32BIT 0
+#endif
+
+// fully unroll the 32-bit SHA-512 rounds (faster, ~2x code size)
+#ifndef SHA512_32BIT_UNROLL
+#define SHA512_32BIT_UNROLL 0
+#endif
+
 // add way how to mark confidential data
 #ifndef CONFIDENTIAL
 // TODO: Add attribute keep confidential variables in SRAM2 CHI-2141
@@ -23,6 +23,7 @@
  */
 
 #include "rfc6979.h"
+#include <string.h>
 #include "hmac_drbg.h"
 #include "memzero.h"
 
@@ -31,6 +32,17 @@ void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash,
   hmac_drbg_init(state, priv_key, 32, hash, 32);
 }
 
+void init_rfc6979_key(const uint8_t *priv_key, rfc6979_key_state *key) {
+  memcpy(key->priv_key, priv_key, sizeof(key->priv_key));
+  hmac_drbg_prepare(&key->drbg, priv_key, 32);
+}
+
+// same as init_rfc6979 without hashing the private key again
+void init_rfc6979_prepared(const rfc6979_key_state *key, const uint8_t *hash,
+                           rfc6979_state *state) {
+  hmac_drbg_init_prepared(state, &key->drbg, key->priv_key, 32, hash, 32);
+}
+
 // generate next number from deterministic random number generator
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *state) {
   hmac_drbg_generate(state, rnd, 32);
@@ -32,8 +32,18 @@
 // rfc6979 pseudo random number generator state
 typedef HMAC_DRBG_CTX rfc6979_state;
 
+// part of the rfc6979 state that only depends on the private key; it can be
+// reused to generate the nonces of any number of digests signed by that key
+typedef struct {
+  HMAC_DRBG_PREPARED drbg;
+  uint8_t priv_key[32];
+} rfc6979_key_state;
+
 void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash,
                   rfc6979_state *rng);
+void init_rfc6979_key(const uint8_t *priv_key, rfc6979_key_state *key);
+void init_rfc6979_prepared(const rfc6979_key_state *key, const uint8_t *hash,
+                           rfc6979_state *rng);
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *rng);
 void generate_k_rfc6979(bignum256 *k, rfc6979_state *rng);
 
@@ -341,3 +341,29 @@ void ripemd160(const uint8_t *msg, uint32_t msg_len, uint8_t hash[RIPEMD160_DIGE
     ripemd160_Update( &ctx, msg, msg_len );
     ripemd160_Final( &ctx, hash );
 }
+
+/*
+ * output = RIPEMD-160( 32-byte input ), processed as a single pre-padded block
+ */
+void ripemd160_32(const uint8_t msg[32], uint8_t hash[RIPEMD160_DIGEST_LENGTH])
+{
+    RIPEMD160_CTX ctx = {0};
+    uint8_t block[RIPEMD160_BLOCK_LENGTH] = {0};
+
+    ripemd160_Init( &ctx );
+    memcpy( block, msg, 32 );
+    block[32] = 0x80;
+    /* message length in bits, little endian */
+    block[56] = 0x00;
+    block[57] = 0x01;
+    ripemd160_process( &ctx, block );
+
+    PUT_UINT32_LE( ctx.state[0], hash,  0 );
+    PUT_UINT32_LE( ctx.state[1], hash,  4 );
+    PUT_UINT32_LE( ctx.state[2], hash,  8 );
+    PUT_UINT32_LE( ctx.state[3], hash, 12 );
+    PUT_UINT32_LE( ctx.state[4], hash, 16 );
+
+    memzero( &ctx, sizeof(ctx) );
+    memzero( block, sizeof(block) );
+}
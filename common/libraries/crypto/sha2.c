@@ -32,6 +32,7 @@
 #include <stdint.h>
 #include "sha2.h"
 #include "memzero.h"
+#include "options.h"
 
 /*
  * ASSERT NOTE:
@@ -965,6 +966,85 @@ void sha256_Raw(const sha2_byte* data, size_t len, uint8_t digest[SHA256_DIGEST_
 	sha256_Final(&context, digest);
 }
 
+/*
+ * Single-block SHA-256 for inputs of at most 55 bytes. The message words,
+ * the 0x80 terminator and the bit length are written straight into the
+ * schedule, skipping the context buffering of sha256_Update/sha256_Final.
+ */
+static void sha256_short_words(const sha2_byte* data, size_t len, sha2_word32 W[16]) {
+	size_t	i = 0;
+
+	memzero(W, 16 * sizeof(sha2_word32));
+	for (i = 0; i < len; i++) {
+		W[i >> 2] |= (sha2_word32)data[i] << (24 - 8 * (i & 3));
+	}
+	W[len >> 2] |= (sha2_word32)0x80 << (24 - 8 * (len & 3));
+	W[15] = (sha2_word32)len << 3;
+}
+
+static void sha256_state_to_bytes(const sha2_word32 state[8], sha2_byte digest[SHA256_DIGEST_LENGTH]) {
+	int	j = 0;
+
+	for (j = 0; j < 8; j++) {
+		digest[4 * j] = (sha2_byte)(state[j] >> 24);
+		digest[4 * j + 1] = (sha2_byte)(state[j] >> 16);
+		digest[4 * j + 2] = (sha2_byte)(state[j] >> 8);
+		digest[4 * j + 3] = (sha2_byte)state[j];
+	}
+}
+
+void sha256_Raw_short(const sha2_byte* data, size_t len, uint8_t digest[SHA256_DIGEST_LENGTH]) {
+	sha2_word32	W[16] = {0}, state[8] = {0};
+
+	if (len > SHA256_SHORT_MAX_LENGTH) {
+		sha256_Raw(data, len, digest);
+		return;
+	}
+	sha256_short_words(data, len, W);
+	sha256_Transform(sha256_initial_hash_value, W, state);
+	sha256_state_to_bytes(state, digest);
+	memzero(W, sizeof(W));
+	memzero(state, sizeof(state));
+}
+
+void sha256_32(const sha2_byte data[32], uint8_t digest[SHA256_DIGEST_LENGTH]) {
+	sha256_Raw_short(data, 32, digest);
+}
+
+void sha256_33(const sha2_byte data[33], uint8_t digest[SHA256_DIGEST_LENGTH]) {
+	sha256_Raw_short(data, 33, digest);
+}
+
+/*
+ * SHA-256(SHA-256(data)) for short inputs. The first state is fed to the
+ * second block as message words directly, without a round trip via bytes.
+ */
+void sha256d_short(const sha2_byte* data, size_t len, uint8_t digest[SHA256_DIGEST_LENGTH]) {
+	sha2_word32	W[16] = {0}, state[8] = {0};
+
+	if (len > SHA256_SHORT_MAX_LENGTH) {
+		sha256_Raw(data, len, digest);
+		sha256_32(digest, digest);
+		return;
+	}
+	sha256_short_words(data, len, W);
+	sha256_Transform(sha256_initial_hash_value, W, state);
+
+	/* second block: 32-byte message, terminator, zeros, 256-bit length */
+	memcpy(W, state, sizeof(state));
+	W[8] = 0x80000000;
+	memzero(&W[9], 6 * sizeof(sha2_word32));
+	W[15] = 256;
+	sha256_Transform(sha256_initial_hash_value, W, state);
+	sha256_state_to_bytes(state, digest);
+	memzero(W, sizeof(W));
+	memzero(state, sizeof(state));
+}
+
+void sha256d_32(const sha2_byte data[32], uint8_t digest[SHA256_DIGEST_LENGTH]) {
+	sha256d_short(data, 32, digest);
+}
+
 char* sha256_Data(const sha2_byte* data, size_t len, char digest[SHA256_DIGEST_STRING_LENGTH]) {
 	SHA256_CTX	context = {0};
 
@@ -984,7 +1064,190 @@ void sha512_Init(SHA512_CTX* context) {
 	context->bitcount[0] = context->bitcount[1] =  0;
 }
 
-#ifdef SHA2_UNROLL_TRANSFORM
+/*
+ * SHA-512 compression for 32-bit targets. Every 64-bit word is held as a
+ * high/low pair of 32-bit words, so that each rotation is two shifts per half
+ * and each addition a single add with an explicit carry, instead of the
+ * generic 64-bit sequences the compiler emits for such targets.
+ */
+
+/* (rh:rl) += (xh:xl); xl must not be rl */
+#define ADD64_32(rh, rl, xh, xl) do { \
+	sha2_word32 _lo = (rl) + (xl); \
+	(rh) += (xh) + (_lo < (xl)); \
+	(rl) = _lo; \
+} while (0)
+
+/* Fused Sigma0_512: ROTR 28 ^ ROTR 34 ^ ROTR 39 */
+#define SIGMA0_512_32(rh, rl, xh, xl) do { \
+	(rh) = ((xh) >> 28 | (xl) << 4) ^ ((xl) >> 2 | (xh) << 30) ^ \
+	       ((xl) >> 7 | (xh) << 25); \
+	(rl) = ((xl) >> 28 | (xh) << 4) ^ ((xh) >> 2 | (xl) << 30) ^ \
+	       ((xh) >> 7 | (xl) << 25); \
+} while (0)
+
+/* Fused Sigma1_512: ROTR 14 ^ ROTR 18 ^ ROTR 41 */
+#define SIGMA1_512_32(rh, rl, xh, xl) do { \
+	(rh) = ((xh) >> 14 | (xl) << 18) ^ ((xh) >> 18 | (xl) << 14) ^ \
+	       ((xl) >> 9 | (xh) << 23); \
+	(rl) = ((xl) >> 14 | (xh) << 18) ^ ((xl) >> 18 | (xh) << 14) ^ \
+	       ((xh) >> 9 | (xl) << 23); \
+} while (0)
+
+/* Fused sigma0_512: ROTR 1 ^ ROTR 8 ^ SHR 7 */
+#define sigma0_512_32(rh, rl, xh, xl) do { \
+	(rh) = ((xh) >> 1 | (xl) << 31) ^ ((xh) >> 8 | (xl) << 24) ^ \
+	       ((xh) >> 7); \
+	(rl) = ((xl) >> 1 | (xh) << 31) ^ ((xl) >> 8 | (xh) << 24) ^ \
+	       ((xl) >> 7 | (xh) << 25); \
+} while (0)
+
+/* Fused sigma1_512: ROTR 19 ^ ROTR 61 ^ SHR 6 */
+#define sigma1_512_32(rh, rl, xh, xl) do { \
+	(rh) = ((xh) >> 19 | (xl) << 13) ^ ((xl) >> 29 | (xh) << 3) ^ \
+	       ((xh) >> 6); \
+	(rl) = ((xl) >> 19 | (xh) << 13) ^ ((xh) >> 29 | (xl) << 3) ^ \
+	       ((xl) >> 6 | (xh) << 26); \
+} while (0)
+
+/* Loads message word j into the rolling schedule */
+#define LOAD512_32(j) do { \
+	Wh[(j)] = (sha2_word32)(data[(j)] >> 32); \
+	Wl[(j)] = (sha2_word32)data[(j)]; \
+} while (0)
+
+/* W[j] = sigma1(W[j-2]) + W[j-7] + sigma0(W[j-15]) + W[j-16], in place */
+#define EXPAND512_32(j) do { \
+	sha2_word32 _sh, _sl; \
+	sigma0_512_32(_sh, _sl, Wh[((j)+1)&0x0f], Wl[((j)+1)&0x0f]); \
+	ADD64_32(Wh[(j)&0x0f], Wl[(j)&0x0f], _sh, _sl); \
+	sigma1_512_32(_sh, _sl, Wh[((j)+14)&0x0f], Wl[((j)+14)&0x0f]); \
+	ADD64_32(Wh[(j)&0x0f], Wl[(j)&0x0f], _sh, _sl); \
+	_sh = Wh[((j)+9)&0x0f]; \
+	_sl = Wl[((j)+9)&0x0f]; \
+	ADD64_32(Wh[(j)&0x0f], Wl[(j)&0x0f], _sh, _sl); \
+} while (0)
+
+/* d += T1; h = T1 + T2; every register is passed as its high/low pair */
+#define COMPRESS512_32(ah,al,bh,bl,ch,cl,dh,dl,eh,el,fh,fl,gh,gl,hh,hl,j) do { \
+	sha2_word32 _t1h = (hh), _t1l = (hl), _t2h, _t2l, _xh, _xl; \
+	SIGMA1_512_32(_xh, _xl, (eh), (el)); \
+	ADD64_32(_t1h, _t1l, _xh, _xl); \
+	_xh = ((eh) & (fh)) ^ (~(eh) & (gh)); \
+	_xl = ((el) & (fl)) ^ (~(el) & (gl)); \
+	ADD64_32(_t1h, _t1l, _xh, _xl); \
+	_xh = (sha2_word32)(K512[(j)] >> 32); \
+	_xl = (sha2_word32)K512[(j)]; \
+	ADD64_32(_t1h, _t1l, _xh, _xl); \
+	_xh = Wh[(j)&0x0f]; \
+	_xl = Wl[(j)&0x0f]; \
+	ADD64_32(_t1h, _t1l, _xh, _xl); \
+	SIGMA0_512_32(_t2h, _t2l, (ah), (al)); \
+	_xh = ((ah) & (bh)) ^ ((ah) & (ch)) ^ ((bh) & (ch)); \
+	_xl = ((al) & (bl)) ^ ((al) & (cl)) ^ ((bl) & (cl)); \
+	ADD64_32(_t2h, _t2l, _xh, _xl); \
+	ADD64_32((dh), (dl), _t1h, _t1l); \
+	(hh) = _t1h; \
+	(hl) = _t1l; \
+	ADD64_32((hh), (hl), _t2h, _t2l); \
+} while (0)
+
+/* Eight rounds; the registers rotate by one position per round */
+#define COMPRESS512_32_X8(SCHEDULE, j) do { \
+	SCHEDULE((j)+0); \
+	COMPRESS512_32(ah,al,bh,bl,ch,cl,dh,dl,eh,el,fh,fl,gh,gl,hh,hl,(j)+0); \
+	SCHEDULE((j)+1); \
+	COMPRESS512_32(hh,hl,ah,al,bh,bl,ch,cl,dh,dl,eh,el,fh,fl,gh,gl,(j)+1); \
+	SCHEDULE((j)+2); \
+	COMPRESS512_32(gh,gl,hh,hl,ah,al,bh,bl,ch,cl,dh,dl,eh,el,fh,fl,(j)+2); \
+	SCHEDULE((j)+3); \
+	COMPRESS512_32(fh,fl,gh,gl,hh,hl,ah,al,bh,bl,ch,cl,dh,dl,eh,el,(j)+3); \
+	SCHEDULE((j)+4); \
+	COMPRESS512_32(eh,el,fh,fl,gh,gl,hh,hl,ah,al,bh,bl,ch,cl,dh,dl,(j)+4); \
+	SCHEDULE((j)+5); \
+	COMPRESS512_32(dh,dl,eh,el,fh,fl,gh,gl,hh,hl,ah,al,bh,bl,ch,cl,(j)+5); \
+	SCHEDULE((j)+6); \
+	COMPRESS512_32(ch,cl,dh,dl,eh,el,fh,fl,gh,gl,hh,hl,ah,al,bh,bl,(j)+6); \
+	SCHEDULE((j)+7); \
+	COMPRESS512_32(bh,bl,ch,cl,dh,dl,eh,el,fh,fl,gh,gl,hh,hl,ah,al,(j)+7); \
+} while (0)
+
+#define ROUNDS512_32_0_TO_15(j) COMPRESS512_32_X8(LOAD512_32, j)
+#define ROUNDS512_32(j) COMPRESS512_32_X8(EXPAND512_32, j)
+
+/* Declares the registers and loads them with the prev. intermediate value */
+#define SHA512_32_BEGIN() \
+	sha2_word32	ah, al, bh, bl, ch, cl, dh, dl, eh, el, fh, fl, gh, gl, hh, hl; \
+	sha2_word32	Wh[16] = {0}, Wl[16] = {0}; \
+	sha2_word64	t = 0; \
+	ah = (sha2_word32)(state_in[0] >> 32); al = (sha2_word32)state_in[0]; \
+	bh = (sha2_word32)(state_in[1] >> 32); bl = (sha2_word32)state_in[1]; \
+	ch = (sha2_word32)(state_in[2] >> 32); cl = (sha2_word32)state_in[2]; \
+	dh = (sha2_word32)(state_in[3] >> 32); dl = (sha2_word32)state_in[3]; \
+	eh = (sha2_word32)(state_in[4] >> 32); el = (sha2_word32)state_in[4]; \
+	fh = (sha2_word32)(state_in[5] >> 32); fl = (sha2_word32)state_in[5]; \
+	gh = (sha2_word32)(state_in[6] >> 32); gl = (sha2_word32)state_in[6]; \
+	hh = (sha2_word32)(state_in[7] >> 32); hl = (sha2_word32)state_in[7]
+
+/* Computes the current intermediate hash value and clears the registers */
+#define SHA512_32_END() do { \
+	t = ((sha2_word64)ah << 32) | al; state_out[0] = state_in[0] + t; \
+	t = ((sha2_word64)bh << 32) | bl; state_out[1] = state_in[1] + t; \
+	t = ((sha2_word64)ch << 32) | cl; state_out[2] = state_in[2] + t; \
+	t = ((sha2_word64)dh << 32) | dl; state_out[3] = state_in[3] + t; \
+	t = ((sha2_word64)eh << 32) | el; state_out[4] = state_in[4] + t; \
+	t = ((sha2_word64)fh << 32) | fl; state_out[5] = state_in[5] + t; \
+	t = ((sha2_word64)gh << 32) | gl; state_out[6] = state_in[6] + t; \
+	t = ((sha2_word64)hh << 32) | hl; state_out[7] = state_in[7] + t; \
+	ah = al = bh = bl = ch = cl = dh = dl = 0; \
+	eh = el = fh = fl = gh = gl = hh = hl = 0; \
+	memzero(Wh, sizeof(Wh)); \
+	memzero(Wl, sizeof(Wl)); \
+	t = 0; \
+} while (0)
+
+void sha512_Transform_32(const sha2_word64* state_in, const sha2_word64* data, sha2_word64* state_out) {
+	SHA512_32_BEGIN();
+	int		j = 0;
+
+	for (j = 0; j < 16; j += 8) {
+		ROUNDS512_32_0_TO_15(j);
+	}
+	for (; j < 80; j += 8) {
+		ROUNDS512_32(j);
+	}
+
+	SHA512_32_END();
+}
+
+void sha512_Transform_32_unrolled(const sha2_word64* state_in, const sha2_word64* data, sha2_word64* state_out) {
+	SHA512_32_BEGIN();
+
+	ROUNDS512_32_0_TO_15(0);
+	ROUNDS512_32_0_TO_15(8);
+	ROUNDS512_32(16);
+	ROUNDS512_32(24);
+	ROUNDS512_32(32);
+	ROUNDS512_32(40);
+	ROUNDS512_32(48);
+	ROUNDS512_32(56);
+	ROUNDS512_32(64);
+	ROUNDS512_32(72);
+
+	SHA512_32_END();
+}
+
+#if USE_SHA512_32BIT
+
+void sha512_Transform(const sha2_word64* state_in, const sha2_word64* data, sha2_word64* state_out) {
+#if SHA512_32BIT_UNROLL
+	sha512_Transform_32_unrolled(state_in, data, state_out);
+#else
+	sha512_Transform_32(state_in, data, state_out);
+#endif
+}
+
+#elif defined(SHA2_UNROLL_TRANSFORM)
 
 /* Unrolled SHA-512 round macros: */
 #define ROUND512_0_TO_15(a,b,c,d,e,f,g,h)	\
@@ -1058,7 +1321,7 @@ void sha512_Transform(const sha2_word64* state_in, const sha2_word64* data, sha2
 	a = b = c = d = e = f = g = h = T1 = 0;
 }
 
-#else /* SHA2_UNROLL_TRANSFORM */
+#else /* USE_SHA512_32BIT, SHA2_UNROLL_TRANSFORM */
 
 void sha512_Transform(const sha2_word64* state_in, const sha2_word64* data, sha2_word64* state_out) {
 	sha2_word64	a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, s0 = 0, s1 = 0;
@@ -1129,7 +1392,7 @@ void sha512_Transform(const sha2_word64* state_in, const sha2_word64* data, sha2
 	a = b = c = d = e = f = g = h = T1 = T2 = 0;
 }
 
-#endif /* SHA2_UNROLL_TRANSFORM */
+#endif /* USE_SHA512_32BIT, SHA2_UNROLL_TRANSFORM */
 
 void sha512_Update(SHA512_CTX* context, const sha2_byte *data, size_t len) {
 	unsigned int	freespace = 0, usedspace = 0;
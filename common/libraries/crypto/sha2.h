@@ -105,7 +105,18 @@ char* sha256_End(SHA256_CTX*, char[SHA256_DIGEST_STRING_LENGTH]);
 void sha256_Raw(const uint8_t*, size_t, uint8_t[SHA256_DIGEST_LENGTH]);
 char* sha256_Data(const uint8_t*, size_t, char[SHA256_DIGEST_STRING_LENGTH]);
 
+/* Single-block SHA-256 of short fixed-size inputs (padding baked in) */
+#define SHA256_SHORT_MAX_LENGTH		55
+void sha256_Raw_short(const uint8_t*, size_t, uint8_t[SHA256_DIGEST_LENGTH]);
+void sha256_32(const uint8_t[32], uint8_t[SHA256_DIGEST_LENGTH]);
+void sha256_33(const uint8_t[33], uint8_t[SHA256_DIGEST_LENGTH]);
+void sha256d_32(const uint8_t[32], uint8_t[SHA256_DIGEST_LENGTH]);
+void sha256d_short(const uint8_t*, size_t, uint8_t[SHA256_DIGEST_LENGTH]);
+
 void sha512_Transform(const uint64_t* state_in, const uint64_t* data, uint64_t* state_out);
+/* 32-bit SHA-512 cores; sha512_Transform uses one when USE_SHA512_32BIT */
+void sha512_Transform_32(const uint64_t* state_in, const uint64_t* data, uint64_t* state_out);
+void sha512_Transform_32_unrolled(const uint64_t* state_in, const uint64_t* data, uint64_t* state_out);
 void sha512_Init(SHA512_CTX*);
 void sha512_Update(SHA512_CTX*, const uint8_t*, size_t);
 void sha512_Final(SHA512_CTX*, uint8_t[SHA512_DIGEST_LENGTH]);
@@ -56,7 +56,10 @@
  *
  ******************************************************************************
  */
+#include "shamir_wrapper.h"
+
 #include "crypto_random.h"
+#include "hmac.h"
 #include "logger.h"
 #include "string.h"
 #include "utils.h"
@@ -274,3 +277,56 @@ int generate_data_5C2(const uint8_t length,
   return verify_shares_NC2(
       5, length, recovered_shamir_data_ver, x_coords, secret);
 }
+
+void shamir_stream_init(shamir_stream_ctx_t *ctx, const uint8_t threshold) {
+  random_generate(ctx->seed, sizeof(ctx->seed));
+  ctx->threshold = threshold;
+}
+
+void shamir_stream_split_block(const shamir_stream_ctx_t *ctx,
+                               const uint16_t block_index,
+                               const uint8_t block_len,
+                               const uint8_t secret[block_len],
+                               const uint8_t x_coord,
+                               uint8_t share_OUT[block_len]) {
+  const uint8_t degree = ctx->threshold - 1;
+  uint8_t coeffs[degree * SHAMIR_STREAM_BLOCK_SIZE];
+  uint8_t message[3] = {block_index >> 8, block_index & 0xFF, 0};
+
+  // Expand the seed into the coefficients of this block, 32 bytes per round
+  for (uint8_t round = 0; round < degree; round++) {
+    message[2] = round;
+    hmac_sha256(ctx->seed,
+                sizeof(ctx->seed),
+                message,
+                sizeof(message),
+                coeffs + round * SHAMIR_STREAM_BLOCK_SIZE);
+  }
+
+  for (uint8_t j = 0; j < block_len; j++) {
+    uint8_t *byte_coeffs = coeffs + j * degree;
+    // Same range as FillRandomVectorInARange(.., 1, 255)
+    for (uint8_t k = 0; k < degree; k++) {
+      byte_coeffs[k] = (byte_coeffs[k] % 255) + 1;
+    }
+    share_OUT[j] = galois_add(secret[j], eval(degree, byte_coeffs, x_coord));
+  }
+  memzero(coeffs, sizeof(coeffs));
+}
+
+void shamir_stream_split(const shamir_stream_ctx_t *ctx,
+                         const uint16_t secret_len,
+                         const uint8_t secret[secret_len],
+                         const uint8_t x_coord,
+                         uint8_t share_OUT[secret_len]) {
+  for (uint16_t offset = 0; offset < secret_len;
+       offset += SHAMIR_STREAM_BLOCK_SIZE) {
+    shamir_stream_split_block(
+        ctx,
+        offset / SHAMIR_STREAM_BLOCK_SIZE,
+        CY_MIN(SHAMIR_STREAM_BLOCK_SIZE, secret_len - offset),
+        secret + offset,
+        x_coord,
+        share_OUT + offset);
+  }
+}
@@ -12,7 +12,27 @@
 #ifndef SHAMIR_WRAPPER_H
 #define SHAMIR_WRAPPER_H
 
+#include <stdbool.h>
 #include <stdint.h>
+
+/// Number of secret bytes split or recovered in one step of the streaming API
+#define SHAMIR_STREAM_BLOCK_SIZE 32
+
+/// Size of the random seed from which the polynomial coefficients are derived
+#define SHAMIR_STREAM_SEED_SIZE 32
+
+/**
+ * @brief Context of a streaming (block by block) split of a secret
+ * @details The coefficients of the polynomial of every block are derived from
+ * the seed, so the shares can be produced one share and one block at a time
+ * without holding the shares of all the cards in RAM. The context must be
+ * cleared with memzero once all the shares are produced.
+ */
+typedef struct {
+  uint8_t seed[SHAMIR_STREAM_SEED_SIZE];
+  uint8_t threshold;
+} shamir_stream_ctx_t;
+
 /**
  * @brief
  * @details size of shares_OUT must be
@@ -56,7 +76,7 @@ void recover_secret_from_shares(
     uint8_t num_shares,    // threshold. shares is a 2D array. visualise this as
                            // vertical height
     const uint8_t shares[num_shares][number_of_bytes],
-    uint8_t x_coords[num_shares],
+    const uint8_t x_coords[num_shares],
     uint8_t secret_OUT[number_of_bytes]);
 
 /**
@@ -103,8 +123,8 @@ void recover_share_from_shares(
 int verify_shares_NC2(
     uint8_t number_of_shares,
     uint8_t secret_size,
-    uint8_t recovered_shamir_data_ver[number_of_shares][secret_size],
-    uint8_t x_coords[number_of_shares],
+    const uint8_t recovered_shamir_data_ver[number_of_shares][secret_size],
+    const uint8_t x_coords[number_of_shares],
     uint8_t secret[secret_size]);
 
 /**
@@ -181,4 +201,48 @@ int generate_data_5C2(uint8_t length,
                       const uint8_t x_coords[5],
                       uint8_t secret[]);
 
+/**
+ * @brief Starts a streaming split by generating a fresh random seed
+ *
+ * @param ctx The context to initialize
+ * @param threshold Number of shares required to recover the secret
+ */
+void shamir_stream_init(shamir_stream_ctx_t *ctx, uint8_t threshold);
+
+/**
+ * @brief Computes the share of one block of the secret for the given x
+ * coordinate
+ * @details The same block index must be used for the same secret block across
+ * all the shares. Share i of convert_to_shares corresponds to x = (i+1).
+ *
+ * @param ctx The initialized split context
+ * @param block_index Index of the block within the secret
+ * @param block_len Size of the block, at most SHAMIR_STREAM_BLOCK_SIZE
+ * @param secret The secret block
+ * @param x_coord The x coordinate of the share
+ * @param share_OUT Buffer receiving block_len bytes of the share
+ */
+void shamir_stream_split_block(const shamir_stream_ctx_t *ctx,
+                               uint16_t block_index,
+                               uint8_t block_len,
+                               const uint8_t secret[block_len],
+                               uint8_t x_coord,
+                               uint8_t share_OUT[block_len]);
+
+/**
+ * @brief Computes the complete share of a secret for the given x coordinate,
+ * one block at a time
+ *
+ * @param ctx The initialized split context
+ * @param secret_len Size of the secret
+ * @param secret The secret
+ * @param x_coord The x coordinate of the share
+ * @param share_OUT Buffer receiving secret_len bytes of the share
+ */
+void shamir_stream_split(const shamir_stream_ctx_t *ctx,
+                         uint16_t secret_len,
+                         const uint8_t secret[secret_len],
+                         uint8_t x_coord,
+                         uint8_t share_OUT[secret_len]);
+
 #endif
@@ -0,0 +1,191 @@
+/**
+ * @file    lz4_block.c
+ * @author  Cypherock X1 Team
+ * @brief   Decoder for the LZ4 block format
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "lz4_block.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/*****************************************************************************
+ * EXTERN VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ *****************************************************************************/
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_RUN_MASK 0x0F
+
+/*****************************************************************************
+ * PRIVATE TYPEDEFS
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ *****************************************************************************/
+
+/**
+ * @brief Reads the extension bytes of a literal or match length
+ *
+ * @param ip Reference to the read position; advanced past the extension
+ * @param end End of the compressed block
+ * @param length Updated with the total length
+ *
+ * @return bool false if the block ends within the extension
+ */
+static bool read_length(const uint8_t **ip,
+                        const uint8_t *end,
+                        size_t *length);
+
+/*****************************************************************************
+ * STATIC FUNCTIONS
+ *****************************************************************************/
+
+static bool read_length(const uint8_t **ip,
+                        const uint8_t *end,
+                        size_t *length) {
+  uint8_t byte = 0xFF;
+
+  while (0xFF == byte) {
+    if (*ip >= end) {
+      return false;
+    }
+    byte = *(*ip)++;
+    *length += byte;
+  }
+  return true;
+}
+
+/*****************************************************************************
+ * GLOBAL FUNCTIONS
+ *****************************************************************************/
+
+int32_t lz4_block_decompress(const uint8_t *src,
+                             size_t src_size,
+                             uint8_t *dst,
+                             size_t dst_size) {
+  if (NULL == src || NULL == dst || 0 == src_size) {
+    return LZ4_BLOCK_ERROR;
+  }
+
+  const uint8_t *ip = src;
+  const uint8_t *const ip_end = src + src_size;
+  uint8_t *op = dst;
+  uint8_t *const op_end = dst + dst_size;
+  // the block lies within the output buffer
+  const bool in_place =
+      ((uintptr_t)src >= (uintptr_t)dst && (uintptr_t)src < (uintptr_t)op_end);
+
+  while (ip < ip_end) {
+    const uint8_t token = *ip++;
+    size_t length = token >> 4;
+
+    // literals
+    if (LZ4_RUN_MASK == length && !read_length(&ip, ip_end, &length)) {
+      return LZ4_BLOCK_ERROR;
+    }
+    if ((size_t)(ip_end - ip) < length || (size_t)(op_end - op) < length ||
+        (in_place && (uintptr_t)op > (uintptr_t)ip)) {
+      return LZ4_BLOCK_ERROR;
+    }
+    memmove(op, ip, length);
+    op += length;
+    ip += length;
+
+    // the last sequence has no match
+    if (ip == ip_end) {
+      break;
+    }
+
+    // match
+    if (2 > ip_end - ip) {
+      return LZ4_BLOCK_ERROR;
+    }
+    const size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    length = token & LZ4_RUN_MASK;
+    if (LZ4_RUN_MASK == length && !read_length(&ip, ip_end, &length)) {
+      return LZ4_BLOCK_ERROR;
+    }
+    length += LZ4_MIN_MATCH;
+    if (0 == offset || (size_t)(op - dst) < offset ||
+        (size_t)(op_end - op) < length ||
+        (in_place && (uintptr_t)(op + length) > (uintptr_t)ip)) {
+      return LZ4_BLOCK_ERROR;
+    }
+    // byte-wise copy as the match may overlap its own output
+    const uint8_t *match = op - offset;
+    while (0 < length--) {
+      *op++ = *match++;
+    }
+  }
+
+  return (int32_t)(op - dst);
+}
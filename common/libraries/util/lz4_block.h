@@ -0,0 +1,62 @@
+/**
+ * @file    lz4_block.h
+ * @author  Cypherock X1 Team
+ * @brief   Decoder for the LZ4 block format
+ * @details The decoder needs no working memory besides the output buffer and
+ * supports in-place decompression, where the compressed block is placed at the
+ * end of the buffer it is decompressed into.
+
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ * target=_blank>https://mitcc.org/</a>
+ *
+ */
+
+#ifndef LZ4_BLOCK_H
+#define LZ4_BLOCK_H
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * MACROS AND DEFINES
+ *****************************************************************************/
+
+/// Returned by lz4_block_decompress() for a malformed or oversized block
+#define LZ4_BLOCK_ERROR (-1)
+
+/*****************************************************************************
+ * TYPEDEFS
+ *****************************************************************************/
+
+/*****************************************************************************
+ * EXPORTED VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ *****************************************************************************/
+
+/**
+ * @brief Decompresses a single LZ4 block (no frame header or checksum)
+ * @details The input may overlap the end of the output buffer. In that case the
+ * block is rejected if the decompressed data would overwrite compressed data
+ * that is not yet consumed; standard compressors stay within bounds as long as
+ * the output buffer has a margin of (decompressed_size / 256) + 32 bytes.
+ *
+ * @param src Compressed block
+ * @param src_size Size of the compressed block
+ * @param dst Output buffer
+ * @param dst_size Capacity of the output buffer
+ *
+ * @return int32_t Size of the decompressed data or LZ4_BLOCK_ERROR
+ */
+int32_t lz4_block_decompress(const uint8_t *src,
+                             size_t src_size,
+                             uint8_t *dst,
+                             size_t dst_size);
+
+#endif
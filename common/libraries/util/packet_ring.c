@@ -0,0 +1,157 @@
+/**
+ * @file    packet_ring.c
+ * @author  Cypherock X1 Team
+ * @brief   Single-producer/single-consumer ring of fixed size packets
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "packet_ring.h"
+
+#include <string.h>
+
+/*****************************************************************************
+ * EXTERN VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ *****************************************************************************/
+
+// The index owned by the other side is loaded with acquire semantics and the
+// own index is published with release semantics so that the slot contents are
+// visible before the index update. On the single core MCU this reduces to a
+// compiler barrier plus a DMB; in the simulator it orders the threads.
+#define RING_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(ptr, value)                                         \
+  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+/*****************************************************************************
+ * PRIVATE TYPEDEFS
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * STATIC FUNCTIONS
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL FUNCTIONS
+ *****************************************************************************/
+bool packet_ring_push(packet_ring_t *ring,
+                      uint8_t tag,
+                      const uint8_t *data,
+                      uint16_t length) {
+  const uint32_t head = ring->head;
+  const uint32_t tail = RING_LOAD_ACQUIRE(&ring->tail);
+
+  if ((head - tail) >= ring->slot_count || length > ring->slot_size ||
+      (NULL == data && 0 != length)) {
+    RING_STORE_RELEASE(&ring->overflow_count, ring->overflow_count + 1);
+    return false;
+  }
+
+  const uint32_t index = head & (ring->slot_count - 1);
+  if (0 != length) {
+    memcpy(ring->buffer + (index * ring->slot_size), data, length);
+  }
+  ring->slots[index].length = length;
+  ring->slots[index].tag = tag;
+  RING_STORE_RELEASE(&ring->head, head + 1);
+  return true;
+}
+
+bool packet_ring_peek(packet_ring_t *ring,
+                      uint8_t *tag,
+                      const uint8_t **data,
+                      uint16_t *length) {
+  const uint32_t tail = ring->tail;
+  const uint32_t head = RING_LOAD_ACQUIRE(&ring->head);
+
+  if (head == tail) {
+    return false;
+  }
+
+  const uint32_t index = tail & (ring->slot_count - 1);
+  *tag = ring->slots[index].tag;
+  *length = ring->slots[index].length;
+  *data = ring->buffer + (index * ring->slot_size);
+  return true;
+}
+
+void packet_ring_pop(packet_ring_t *ring) {
+  const uint32_t tail = ring->tail;
+
+  if (RING_LOAD_ACQUIRE(&ring->head) == tail) {
+    return;
+  }
+  RING_STORE_RELEASE(&ring->tail, tail + 1);
+}
+
+uint32_t packet_ring_get_overflow_count(const packet_ring_t *ring) {
+  return RING_LOAD_ACQUIRE(&ring->overflow_count);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    packet_ring.h
+ * @author  Cypherock X1 Team
+ * @brief   Single-producer/single-consumer ring of fixed size packets
+ * @details The producer (typically an interrupt handler) and the consumer
+ * (thread context) each own one index of the ring, so no locking is needed as
+ * long as there is exactly one of each. Packets are consumed in place to avoid
+ * a second copy.
+
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ * target=_blank>https://mitcc.org/</a>
+ *
+ */
+
+#ifndef PACKET_RING_H
+#define PACKET_RING_H
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * MACROS AND DEFINES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * TYPEDEFS
+ *****************************************************************************/
+
+typedef struct {
+  uint16_t length;  /**< Length of the packet held by the slot */
+  uint8_t tag;      /**< Opaque value stored along with the packet */
+} packet_ring_slot_t;
+
+/**
+ * The storage is provided by the user. slot_count must be a power of two and
+ * buffer must hold slot_count * slot_size bytes. head, tail and overflow_count
+ * must be zero initially.
+ */
+typedef struct {
+  uint8_t *buffer;            /**< Packet storage of all the slots */
+  packet_ring_slot_t *slots;  /**< Metadata of each slot */
+  uint16_t slot_size;         /**< Largest packet accepted */
+  uint16_t slot_count;        /**< Number of slots, power of two */
+  uint32_t head;              /**< Written by the producer only */
+  uint32_t tail;              /**< Written by the consumer only */
+  uint32_t overflow_count;    /**< Packets dropped by the producer */
+} packet_ring_t;
+
+/*****************************************************************************
+ * EXPORTED VARIABLES
+ *****************************************************************************/
+
+/*****************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ *****************************************************************************/
+
+/**
+ * @brief Copies a packet into the next free slot. Producer side.
+ * @details The packet is dropped and the overflow counter incremented if the
+ * ring is full or the packet does not fit a slot.
+ *
+ * @param ring Pointer to the ring instance
+ * @param tag Opaque value returned along with the packet
+ * @param data Packet to be queued
+ * @param length Length of the packet
+ * @return true If the packet was queued
+ * @return false If the packet was dropped
+ */
+bool packet_ring_push(packet_ring_t *ring,
+                      uint8_t tag,
+                      const uint8_t *data,
+                      uint16_t length);
+
+/**
+ * @brief Returns the oldest queued packet without removing it. Consumer side.
+ * @details The packet stays valid until packet_ring_pop() is called.
+ *
+ * @param ring Pointer to the ring instance
+ * @param tag Filled with the tag of the packet
+ * @param data Filled with a reference to the packet inside the ring
+ * @param length Filled with the length of the packet
+ * @return true If a packet is available
+ * @return false If the ring is empty
+ */
+bool packet_ring_peek(packet_ring_t *ring,
+                      uint8_t *tag,
+                      const uint8_t **data,
+                      uint16_t *length);
+
+/**
+ * @brief Releases the packet returned by packet_ring_peek(). Consumer side.
+ *
+ * @param ring Pointer to the ring instance
+ */
+void packet_ring_pop(packet_ring_t *ring);
+
+/**
+ * @brief Returns the number of packets dropped since the ring was created
+ *
+ * @param ring Pointer to the ring instance
+ * @return uint32_t The count of dropped packets
+ */
+uint32_t packet_ring_get_overflow_count(const packet_ring_t *ring);
+
+#endif /* PACKET_RING_H */
@@ -74,6 +74,13 @@
 #include "sha2.h"
 #include "wallet.h"
 
+// Logs every formatted amount; can be trimmed independently of LOG_LEVEL
+#ifndef UTILS_LOG_LEVEL
+#define UTILS_LOG_LEVEL LOG_LEVEL
+#endif
+#undef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL UTILS_LOG_LEVEL
+
 /**
  * @brief struct for
  * @details
@@ -63,19 +63,17 @@
 #include "bip32.h"
 #include "bip39.h"
 #include "curves.h"
+#include "hmac.h"
 #include "logger.h"
+#include "memzero.h"
+#include "progress_api.h"
 #include "sha2.h"
 #include "utils.h"
 
-void calculate_wallet_id(uint8_t wallet_id[WALLET_ID_SIZE],
-                         const char *mnemonics) {
+static void wallet_id_from_seed(uint8_t wallet_id[WALLET_ID_SIZE],
+                                const uint8_t seed[64]) {
   HDNode node;
-  uint8_t seed[64];
-  char passphrase[256];
 
-  memset(seed, 0, 64);
-  memset(passphrase, 0, 256);
-  mnemonic_to_seed(mnemonics, passphrase, seed, NULL);
   // m
   hdnode_from_seed(seed, 64, SECP256K1_NAME, &node);
   hdnode_fill_public_key(&node);
@@ -86,15 +84,52 @@ void calculate_wallet_id(uint8_t wallet_id[WALLET_ID_SIZE],
   hdnode_private_ckd(&node, 0x00000001);    // m/1000'/0'/3'/1
   hdnode_fill_public_key(&node);
 
-  sha256_Raw(node.public_key, sizeof(node.public_key), wallet_id);
-  sha256_Raw(wallet_id, SHA256_DIGEST_LENGTH, wallet_id);
+  sha256_33(node.public_key, wallet_id);
+  sha256_32(wallet_id, wallet_id);
+  memzero(&node, sizeof(node));
+}
+
+bool calculate_wallet_id(uint8_t wallet_id[WALLET_ID_SIZE],
+                         const char *mnemonics) {
+  uint8_t seed[64] = {0};
+
+  // The derivation yields to the progress api so that a P0 event can cut it
+  if (0 == mnemonic_to_seed_yield(mnemonics, "", seed, progress_api_yield)) {
+    memzero(seed, sizeof(seed));
+    return false;
+  }
+  wallet_id_from_seed(wallet_id, seed);
+  memzero(seed, sizeof(seed));
+  return true;
+}
+
+void calculate_seed_tag(const uint8_t wallet_id[WALLET_ID_SIZE],
+                        const uint8_t *entropy,
+                        uint8_t entropy_size,
+                        uint8_t seed_tag[WALLET_SEED_TAG_SIZE]) {
+  // Domain separation from any other use of the wallet id as a key
+  static const char domain[] = "X1 wallet seed tag";
+  HMAC_SHA256_CTX hmac_ctx = {0};
+
+  hmac_sha256_Init(&hmac_ctx, wallet_id, WALLET_ID_SIZE);
+  hmac_sha256_Update(&hmac_ctx, (const uint8_t *)domain, sizeof(domain) - 1);
+  hmac_sha256_Update(&hmac_ctx, entropy, entropy_size);
+  hmac_sha256_Final(&hmac_ctx, seed_tag);
+  memzero(&hmac_ctx, sizeof(hmac_ctx));
 }
 
 bool verify_wallet_id(const uint8_t wallet_id[WALLET_ID_SIZE],
                       const char *mnemonics) {
   uint8_t generated_wallet_id[WALLET_ID_SIZE] = {0};
+  uint8_t seed[64] = {0};
+
+  // The derivation yields to the progress api so that a P0 event can cut it
+  if (0 == mnemonic_to_seed_yield(mnemonics, "", seed, progress_api_yield)) {
+    return false;
+  }
+  wallet_id_from_seed(generated_wallet_id, seed);
+  memzero(seed, sizeof(seed));
 
-  calculate_wallet_id(generated_wallet_id, mnemonics);
   if (0 == memcmp(wallet_id, generated_wallet_id, WALLET_ID_SIZE)) {
     return true;
   } else {
@@ -104,18 +139,19 @@ bool verify_wallet_id(const uint8_t wallet_id[WALLET_ID_SIZE],
   }
 }
 
-void derive_beneficiary_key(
+bool derive_beneficiary_key(
     uint8_t beneficiary_key[BENEFICIARY_KEY_SIZE],
     uint8_t iv_for_beneficiary_key[IV_FOR_BENEFICIARY_KEY_SIZE],
     const char *mnemonics) {
   HDNode node;
-  uint8_t seed[64];
-  char passphrase[256];
+  uint8_t seed[64] = {0};
 
-  memset(seed, 0, 64);
-  memset(passphrase, 0, 256);
-  mnemonic_to_seed(mnemonics, passphrase, seed, NULL);
+  if (0 == mnemonic_to_seed_yield(mnemonics, "", seed, progress_api_yield)) {
+    memzero(seed, sizeof(seed));
+    return false;
+  }
   hdnode_from_seed(seed, 64, SECP256K1_NAME, &node);    // m
+  memzero(seed, sizeof(seed));
   hdnode_private_ckd(&node, 0x800003E8);
   hdnode_private_ckd(&node, 0x80000000);
   hdnode_private_ckd(&node, 0x80000004);
@@ -129,17 +165,21 @@ void derive_beneficiary_key(
   bytes_copied += BENEFICIARY_KEY_SIZE;
   memcpy(
       iv_for_beneficiary_key, hash + bytes_copied, IV_FOR_BENEFICIARY_KEY_SIZE);
+  memzero(&node, sizeof(node));
+  memzero(hash, sizeof(hash));
+  return true;
 }
 
-void derive_wallet_key(uint8_t key[KEY_SIZE], const char *mnemonics) {
+bool derive_wallet_key(uint8_t key[KEY_SIZE], const char *mnemonics) {
   HDNode node;
-  uint8_t seed[64];
-  char passphrase[256];
+  uint8_t seed[64] = {0};
 
-  memset(seed, 0, 64);
-  memset(passphrase, 0, 256);
-  mnemonic_to_seed(mnemonics, passphrase, seed, NULL);
+  if (0 == mnemonic_to_seed_yield(mnemonics, "", seed, progress_api_yield)) {
+    memzero(seed, sizeof(seed));
+    return false;
+  }
   hdnode_from_seed(seed, 64, SECP256K1_NAME, &node);    // m
+  memzero(seed, sizeof(seed));
   hdnode_private_ckd(&node, 0x800003E8);
   hdnode_private_ckd(&node, 0x80000000);
   hdnode_private_ckd(&node, 0x80000002);
@@ -148,6 +188,9 @@ void derive_wallet_key(uint8_t key[KEY_SIZE], const char *mnemonics) {
   uint8_t hash[KEY_SIZE];
   sha256_Raw(node.private_key, sizeof(node.private_key), hash);
   memcpy(key, hash, KEY_SIZE);
+  memzero(&node, sizeof(node));
+  memzero(hash, sizeof(hash));
+  return true;
 }
 
 Card_Data_errors_t validate_wallet(Wallet *wallet) {
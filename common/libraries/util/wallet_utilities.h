@@ -29,6 +29,10 @@
 /**
  * @brief Verify wallet id with wallet id generated from mnemonics
  *
+ * @details The seed derivation yields to progress_api_yield(), so it is
+ * abandoned (and false returned) when a P0 event occurs in between. Use
+ * progress_api_is_aborted() to tell it apart from a mismatch.
+ *
  * @return true if all wallet id matches the wallet id generated from mnemonics,
  * else false
  *
@@ -38,12 +42,13 @@ bool verify_wallet_id(const uint8_t wallet_id[WALLET_ID_SIZE],
 
 /**
  * @brief Calculate wallet id from mnemonics
- * @details
+ * @details The seed derivation yields to progress_api_yield() like
+ * verify_wallet_id(), so a P0 event abandons it.
  *
  * @param wallet_id
  * @param mnemonics
  *
- * @return
+ * @return true if the wallet id was calculated, false if abandoned
  * @retval
  *
  * @see
@@ -51,16 +56,34 @@ bool verify_wallet_id(const uint8_t wallet_id[WALLET_ID_SIZE],
  *
  * @note
  */
-void calculate_wallet_id(uint8_t wallet_id[WALLET_ID_SIZE],
+bool calculate_wallet_id(uint8_t wallet_id[WALLET_ID_SIZE],
                          const char *mnemonics);
 
+/**
+ * @brief Calculates the check value of the wallet entropy
+ * @details The check value is an HMAC-SHA256 of the entropy keyed with the
+ * wallet id. Once stored along with the wallet, it confirms that reconstructed
+ * entropy belongs to the wallet without the PBKDF2 seed derivation and BIP32
+ * walk needed by verify_wallet_id().
+ *
+ * @param wallet_id Id of the wallet the entropy belongs to
+ * @param entropy Wallet entropy recombined from the shares
+ * @param entropy_size Size of the entropy in bytes
+ * @param seed_tag Output buffer for the check value
+ */
+void calculate_seed_tag(const uint8_t wallet_id[WALLET_ID_SIZE],
+                        const uint8_t *entropy,
+                        uint8_t entropy_size,
+                        uint8_t seed_tag[WALLET_SEED_TAG_SIZE]);
+
 /**
  * @brief
  * @details
  *
  * @param
  *
- * @return
+ * @return true if the key was derived, false if a P0 event abandoned the
+ * seed derivation
  * @retval
  *
  * @see
@@ -68,7 +91,7 @@ void calculate_wallet_id(uint8_t wallet_id[WALLET_ID_SIZE],
  *
  * @note
  */
-void derive_beneficiary_key(
+bool derive_beneficiary_key(
     uint8_t beneficiary_key[BENEFICIARY_KEY_SIZE],
     uint8_t iv_for_beneficiary_key[IV_FOR_BENEFICIARY_KEY_SIZE],
     const char *mnemonics);
@@ -81,7 +104,8 @@ void derive_beneficiary_key(
  * @param [out] key         32 byte key for chacha polly
  * @param       mnemonics   Mnemonics
  *
- * @return
+ * @return true if the key was derived, false if a P0 event abandoned the
+ * seed derivation
  * @retval
  *
  * @see
@@ -92,7 +116,7 @@ void derive_beneficiary_key(
  * node = m/190'/1' <br/>
  * key = sha256(node.private_key)
  */
-void derive_wallet_key(uint8_t key[KEY_SIZE], const char *mnemonics);
+bool derive_wallet_key(uint8_t key[KEY_SIZE], const char *mnemonics);
 
 /**
  * @brief Validates the contents of Wallet instance. If any check fails,
@@ -78,6 +78,9 @@ extern const char *GIT_BRANCH;
 /// Stores log details
 static logger_data_s_t sg_log_data;
 
+/// Least important level logged at runtime
+static uint8_t sg_log_level = LOG_LEVEL;
+
 /**
  * @brief Move to the next page and adds spaces to fill gap
  * @details
@@ -141,6 +144,18 @@ void logger(char *fmt, ...) {
   }
 }
 
+void logger_set_level(uint8_t level) {
+  sg_log_level = level;
+}
+
+uint8_t logger_get_level(void) {
+  return sg_log_level;
+}
+
+void logger_apply_config(void) {
+  logger_set_level(is_logging_enabled() ? LOG_LEVEL : LOG_LEVEL_CRITICAL);
+}
+
 void logger_reset_flash(void) {
   erase_cmd(LOG_SECTION_START, LOG_MAX_PAGES * FLASH_PAGE_SIZE);
   sg_log_data.page_index = 0;
@@ -190,6 +205,7 @@ void logger_init(void) {
 
   sg_log_data.initialized = true;
   sg_log_data.read_sm_e = LOG_READ_FINISH;
+  logger_apply_config();
 #endif
 }
 
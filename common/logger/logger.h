@@ -62,32 +62,100 @@ typedef struct {
  */
 void logger(char *fmt, ...);
 
+/**
+ * Every module logs at most up to LOG_MODULE_LEVEL, which defaults to the
+ * global LOG_LEVEL. A module lowers its own level by redefining it after its
+ * includes:
+ *
+ *   #undef LOG_MODULE_LEVEL
+ *   #define LOG_MODULE_LEVEL LOG_LEVEL_ERROR
+ */
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL LOG_LEVEL
+#endif
+
 /// Main logger method
 #if USE_SIMULATOR == 0
-
-#ifndef RELEASE_BUILD
-#define LOG_SWV printf
-#define LOG_INFO logger
+#define LOG_SINK logger
 #else
-#define LOG_SWV(...)
-#define LOG_INFO(...)
+#define LOG_SINK printf
 #endif
 
-#define LOG_CRITICAL logger
-#define LOG_ERROR logger
+/**
+ * Logs only if the level is enabled for the module and at runtime. The module
+ * check is constant, so disabled call sites are dropped by the compiler along
+ * with their format strings and arguments.
+ */
+#define LOG_AT_LEVEL(level, sink, ...)                                         \
+  do {                                                                         \
+    if ((level) <= LOG_MODULE_LEVEL && (level) <= logger_get_level()) {        \
+      sink(__VA_ARGS__);                                                       \
+    }                                                                          \
+  } while (0)
+
+/**
+ * Statement generating no code, for the levels not compiled in. The call stays
+ * visible to the compiler, so variables used only by a log are not reported as
+ * unused and the format is still checked against the arguments.
+ */
+#define LOG_DISABLED(sink, ...)                                                \
+  do {                                                                         \
+    if (0) {                                                                   \
+      sink(__VA_ARGS__);                                                       \
+    }                                                                          \
+  } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_SWV
+#define LOG_SWV(...) LOG_AT_LEVEL(LOG_LEVEL_SWV, printf, __VA_ARGS__)
+#else
+#define LOG_SWV(...) LOG_DISABLED(printf, __VA_ARGS__)
+#endif
 
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_AT_LEVEL(LOG_LEVEL_INFO, LOG_SINK, __VA_ARGS__)
 #else
+#define LOG_INFO(...) LOG_DISABLED(LOG_SINK, __VA_ARGS__)
+#endif
 
-#define LOG_SWV printf
-#define LOG_INFO printf
-#define LOG_ERROR printf
-#define LOG_CRITICAL printf
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_AT_LEVEL(LOG_LEVEL_ERROR, LOG_SINK, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_DISABLED(LOG_SINK, __VA_ARGS__)
+#endif
 
+#if LOG_LEVEL >= LOG_LEVEL_CRITICAL
+#define LOG_CRITICAL(...)                                                      \
+  LOG_AT_LEVEL(LOG_LEVEL_CRITICAL, LOG_SINK, __VA_ARGS__)
+#else
+#define LOG_CRITICAL(...) LOG_DISABLED(LOG_SINK, __VA_ARGS__)
 #endif
 
 /// Increments the passed var within the limits of the passed max
 #define CYCLIC_INCREMENT(var, max) ((var + 1) % max)
 
+/**
+ * @brief Sets the least important level logged at runtime
+ * @details Only narrows the levels compiled in; @see LOG_LEVEL
+ *
+ * @param level One of LOG_LEVEL_NONE to LOG_LEVEL_SWV
+ */
+void logger_set_level(uint8_t level);
+
+/**
+ * @brief Returns the least important level logged at runtime
+ *
+ * @return uint8_t One of LOG_LEVEL_NONE to LOG_LEVEL_SWV
+ */
+uint8_t logger_get_level(void);
+
+/**
+ * @brief Applies the logging setting of the user to the runtime level
+ * @details With logging enabled, every level compiled in is logged; otherwise
+ * only critical events are recorded. Called on init and whenever the setting
+ * changes.
+ */
+void logger_apply_config(void);
+
 /**
  * @brief Task to read logs from flash to provided buffer in RAM.
  * @details The function internally maintains states to manage transferring logs
@@ -25,4 +25,24 @@
 #define DEBUG_TO_TERMINAL (1)
 #define DEBUG_TO_APP (1)
 
+/// Log levels, from the most to the least important
+#define LOG_LEVEL_NONE (0)
+#define LOG_LEVEL_CRITICAL (1)
+#define LOG_LEVEL_ERROR (2)
+#define LOG_LEVEL_INFO (3)
+#define LOG_LEVEL_SWV (4)
+
+/**
+ * Least important level compiled in. Call sites of less important levels are
+ * removed from the binary. Override with -DLOG_LEVEL=LOG_LEVEL_<level>, e.g.
+ * through the LOG_LEVEL cmake option.
+ */
+#ifndef LOG_LEVEL
+#if defined(RELEASE_BUILD) && USE_SIMULATOR == 0
+#define LOG_LEVEL LOG_LEVEL_ERROR
+#else
+#define LOG_LEVEL LOG_LEVEL_SWV
+#endif
+#endif
+
 #endif    // LOGGER_CONFIG_H
\ No newline at end of file
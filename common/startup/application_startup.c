@@ -102,7 +102,9 @@
 #include "lv_drv_conf.h"
 #include "lv_port_disp.h"
 #include "lv_port_indev.h"
+#include "sim_snapshot.h"
 #include "sim_usb.h"
+#include "sim_usb_session.h"
 #include "time.h"
 
 static void sim_hal_init(void);
@@ -292,7 +294,10 @@ void application_init() {
   }
   logger_init();
 #else
-  srand(time(0));
+  // A restored snapshot seeds the RNG itself for reproducible runs
+  if (!sim_snapshot_init()) {
+    srand(time(0));
+  }
   /*Initialize LittlevGL*/
   lv_init();
   sim_hal_init();
@@ -537,7 +542,7 @@ static void sim_hal_init(void) {
   lv_indev_drv_t kb_drv;
   lv_indev_drv_init(&kb_drv);
   kb_drv.type = LV_INDEV_TYPE_KEYPAD;
-  kb_drv.read_cb = keyboard_read;
+  kb_drv.read_cb = sim_session_keyboard_read;
   indev_keypad = lv_indev_drv_register(&kb_drv);
 
   /* Tick init.
@@ -7,6 +7,7 @@
 #include "flash.h"
 #include "lvgl.h"
 #include "sim_usb.h"
+#include "sim_usb_session.h"
 #include "stdlib.h"
 
 uint32_t buzzer_counter = 0;
@@ -183,6 +184,9 @@ void BSP_reset(void) {
 }
 
 void BSP_DelayMs(uint32_t delayValue) {
+  // Recorded sessions are replayed at maximum speed
+  if (sim_session_is_replaying() && delayValue > 1)
+    delayValue = 1;
   SDL_Delay(delayValue);
 }
 
@@ -4,14 +4,10 @@
 #include <stdio.h>
 
 #include "flash_if.h"
+#include "sim_instance.h"
 
 typedef enum { DATA_FILE, LOG_FILE, PERM_DATA_FILE, FW_DATA_FILE } file_type;
 
-#define DATA_FILE_NAME "sim_data.bin"
-#define LOG_FILE_NAME "sim_log.bin"
-#define PERM_DATA_FILE_NAME "sim_pdata.bin"
-#define FW_DATA_FILE_NAME "sim_fw_data.bin"
-
 #ifndef DEBUGGING_WITHOUT_BOOTLOADER
 #define DATA_BASE (FLASH_DATA_ADDRESS)
 #define DATA_END (FLASH_DATA_END_ADDRESS)
@@ -60,48 +56,56 @@ uint32_t GET_BASE_ADDRESS(uint32_t addr) {
   return -1;
 }
 
+static FILE *open_file(const char *file_name, const char *mode) {
+  char path[SIM_INSTANCE_MAX_PATH_LEN];
+
+  if (NULL == file_name)
+    return NULL;
+  return fopen(sim_instance_path(NULL, file_name, path, sizeof(path)), mode);
+}
+
 static int init_file(file_type file_tp) {
   FILE *file = NULL;
   uint8_t bytes[] = {0xff, 0xff, 0xff, 0xff};
   uint8_t page_cnt = 0;
   switch (file_tp) {
     case DATA_FILE:
-      file = fopen(DATA_FILE_NAME, "r");
+      file = open_file(DATA_FILE_NAME, "r");
       if (file != NULL) {
         fclose(file);
         return STM_SUCCESS;
       }
-      file = fopen(DATA_FILE_NAME, "wb");
+      file = open_file(DATA_FILE_NAME, "wb");
       page_cnt = DATA_PG_CNT;
       break;
 
     case LOG_FILE:
-      file = fopen(LOG_FILE_NAME, "r");
+      file = open_file(LOG_FILE_NAME, "r");
       if (file != NULL) {
         fclose(file);
         return STM_SUCCESS;
       }
-      file = fopen(LOG_FILE_NAME, "wb");
+      file = open_file(LOG_FILE_NAME, "wb");
       page_cnt = LOG_PG_CNT;
       break;
 
     case PERM_DATA_FILE:
-      file = fopen(PERM_DATA_FILE_NAME, "r");
+      file = open_file(PERM_DATA_FILE_NAME, "r");
       if (file != NULL) {
         fclose(file);
         return STM_SUCCESS;
       }
-      file = fopen(PERM_DATA_FILE_NAME, "wb");
+      file = open_file(PERM_DATA_FILE_NAME, "wb");
       page_cnt = PERM_DATA_PG_CNT;
       break;
 
     case FW_DATA_FILE:
-      file = fopen(FW_DATA_FILE_NAME, "r");
+      file = open_file(FW_DATA_FILE_NAME, "r");
       if (file != NULL) {
         fclose(file);
         return STM_SUCCESS;
       }
-      file = fopen(FW_DATA_FILE_NAME, "wb");
+      file = open_file(FW_DATA_FILE_NAME, "wb");
       page_cnt = FW_DATA_PG_CNT;
       break;
 
@@ -132,7 +136,7 @@ static void init() {
 
 int read_file(uint32_t addr, uint32_t *dstAddr, uint32_t length) {
   init();
-  FILE *file = fopen(GET_FILE_FROM_ADDRESS(addr), "rb");
+  FILE *file = open_file(GET_FILE_FROM_ADDRESS(addr), "rb");
   if (!file)
     return STM_ERROR_INTERNAL;
   uint32_t offset = addr - GET_BASE_ADDRESS((uint32_t)addr);
@@ -151,7 +155,7 @@ int read_file(uint32_t addr, uint32_t *dstAddr, uint32_t length) {
 
 int erase_file(uint32_t page_address, uint32_t noOfpages) {
   init();
-  FILE *file = fopen(GET_FILE_FROM_ADDRESS(page_address), "rb+");
+  FILE *file = open_file(GET_FILE_FROM_ADDRESS(page_address), "rb+");
   uint8_t bytes[] = {0xff, 0xff, 0xff, 0xff};
   uint32_t count = (FLASH_SIM_PAGE_SIZE * noOfpages) / sizeof(bytes);
   if (!file)
@@ -174,7 +178,7 @@ int erase_file(uint32_t page_address, uint32_t noOfpages) {
 
 int write_file(uint32_t *dstAddr, const uint32_t *srcAddr, uint32_t noOfWords) {
   init();
-  FILE *file = fopen(GET_FILE_FROM_ADDRESS((size_t)dstAddr), "rb+");
+  FILE *file = open_file(GET_FILE_FROM_ADDRESS((size_t)dstAddr), "rb+");
   if (!file)
     return STM_ERROR_INTERNAL;
   uint32_t offset = ((size_t)dstAddr) - GET_BASE_ADDRESS((size_t)dstAddr);
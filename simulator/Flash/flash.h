@@ -7,6 +7,13 @@
 #include "board.h"
 #include "logger.h"
 
+/* Backing files of the flash regions; DATA and LOG hold the flash image while
+ * PERM_DATA and FW_DATA hold the firewall protected (secure) flash */
+#define DATA_FILE_NAME "sim_data.bin"
+#define LOG_FILE_NAME "sim_log.bin"
+#define PERM_DATA_FILE_NAME "sim_pdata.bin"
+#define FW_DATA_FILE_NAME "sim_fw_data.bin"
+
 #define FLASH_SIM_PAGE_SIZE LOG_PAGE_SIZE
 #define TRANSLATE_ADDR(addr, base) (addr - base)
 
@@ -4,14 +4,19 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "sim_instance.h"
+#include "sim_usb_session.h"
+#include "usb_api_priv.h"
+
 #ifdef _WIN32
 #define TEMP_ENV_VAR "TEMP"
-#define SIM_USB_RX_FILE_NAME "cypherock_device_in.bin"
-#define SIM_USB_TX_FILE_NAME "cypherock_device_out.bin"
+#define SIM_USB_DEFAULT_DIR getenv(TEMP_ENV_VAR)
 #else
-#define SIM_USB_RX_FILE_NAME "/tmp/cypherock_device_in.bin"
-#define SIM_USB_TX_FILE_NAME "/tmp/cypherock_device_out.bin"
+#define SIM_USB_DEFAULT_DIR "/tmp"
 #endif
+#define SIM_USB_RX_FILE_NAME "cypherock_device_in.bin"
+#define SIM_USB_TX_FILE_NAME "cypherock_device_out.bin"
+#define SIM_USB_POLL_INTERVAL_US 1000
 
 static FILE *rx_file = NULL;
 static FILE *tx_file = NULL;
@@ -23,20 +28,36 @@ static void check_for_usb_data();
 static int8_t SIM_Receive_FS(const uint8_t *Buf, const uint32_t *Len);
 static uint32_t seek_pos = 0;
 
+static void get_usb_file_path(const char *file_name, char *path, size_t len) {
+  sim_instance_path(SIM_USB_DEFAULT_DIR, file_name, path, len);
+}
+
+static void inject_host_packet(const uint8_t *data, uint32_t len) {
+  SIM_Receive_FS(data, &len);
+}
+
+/* Emulates the USB interrupt: host packets are queued in the receive ring from
+ * this thread and parsed by the application loop. It is the only reader of the
+ * host packet file. */
+static void *usb_rx_thread(void *arg) {
+  (void)arg;
+  if (sim_session_is_replaying()) {
+    sim_session_replay(inject_host_packet);
+    return NULL;
+  }
+  while (1) {
+    check_for_usb_data();
+    usleep(SIM_USB_POLL_INTERVAL_US);
+  }
+  return NULL;
+}
+
 void SIM_USB_DEVICE_Init() {
-  char file_name[250];
+  char file_name[SIM_INSTANCE_MAX_PATH_LEN];
 
   errno = 0;
 
-#ifdef _WIN32
-  snprintf(file_name,
-           sizeof(file_name),
-           "%s\\%s",
-           getenv(TEMP_ENV_VAR),
-           SIM_USB_RX_FILE_NAME);
-#else
-  snprintf(file_name, sizeof(file_name), "%s", SIM_USB_RX_FILE_NAME);
-#endif
+  get_usb_file_path(SIM_USB_RX_FILE_NAME, file_name, sizeof(file_name));
 
   rx_file = fopen(file_name, "wb");
   if (errno) {
@@ -45,15 +66,7 @@ void SIM_USB_DEVICE_Init() {
   }
   fclose(rx_file);
 
-#ifdef _WIN32
-  snprintf(file_name,
-           sizeof(file_name),
-           "%s\\%s",
-           getenv(TEMP_ENV_VAR),
-           SIM_USB_TX_FILE_NAME);
-#else
-  snprintf(file_name, sizeof(file_name), "%s", SIM_USB_TX_FILE_NAME);
-#endif
+  get_usb_file_path(SIM_USB_TX_FILE_NAME, file_name, sizeof(file_name));
   tx_file = fopen(file_name, "wb");
   fclose(tx_file);
   if (errno)
@@ -61,20 +74,17 @@ void SIM_USB_DEVICE_Init() {
 
   rx_file = NULL;
   tx_file = NULL;
+
+  sim_session_init();
+  if (0 != pthread_create(&ptid, NULL, usb_rx_thread, NULL))
+    perror("usb thread");
 }
 
 void SIM_Transmit_FS(uint8_t *data, uint8_t size) {
-  char file_name[250];
+  char file_name[SIM_INSTANCE_MAX_PATH_LEN];
 
-#ifdef _WIN32
-  snprintf(file_name,
-           sizeof(file_name),
-           "%s\\%s",
-           getenv(TEMP_ENV_VAR),
-           SIM_USB_TX_FILE_NAME);
-#else
-  snprintf(file_name, sizeof(file_name), "%s", SIM_USB_TX_FILE_NAME);
-#endif
+  sim_session_on_device_packet(data, size);
+  get_usb_file_path(SIM_USB_TX_FILE_NAME, file_name, sizeof(file_name));
 
   errno = 0;
   tx_file = fopen(file_name, "ab");
@@ -95,28 +105,22 @@ void SIM_Transmit_FS(uint8_t *data, uint8_t size) {
 }
 
 static int8_t SIM_Receive_FS(const uint8_t *Buf, const uint32_t *Len) {
-  // TODO
+  sim_session_on_host_packet(Buf, *Len);
+  comm_packet_enqueue(Buf, *Len, COMM_LIBUSB__HID);
   return (USBD_OK);
-  /* USER CODE END 6 */
 }
 
 static void check_for_usb_data() {
   FILE *file;
-  char file_name[250];
+  char file_name[SIM_INSTANCE_MAX_PATH_LEN];
 
-#ifdef _WIN32
-  snprintf(file_name,
-           sizeof(file_name),
-           "%s\\%s",
-           getenv(TEMP_ENV_VAR),
-           SIM_USB_RX_FILE_NAME);
-#else
-  snprintf(file_name, sizeof(file_name), "%s", SIM_USB_RX_FILE_NAME);
-#endif
+  get_usb_file_path(SIM_USB_RX_FILE_NAME, file_name, sizeof(file_name));
 
   uint8_t buffer[2048];
 
   file = fopen(file_name, "rb");
+  if (!file)
+    return;
   fseek(file, seek_pos, SEEK_SET);
   errno = 0;
   uint32_t count = fread(buffer, sizeof(uint8_t), COMM_HEADER_SIZE, file);
@@ -141,9 +145,6 @@ static void check_for_usb_data() {
     file = fopen(file_name, "wb");
     if (file)
       fclose(file);
+    seek_pos = 0;
   }
-}
-
-void usbsim_continue_loop() {
-  check_for_usb_data();
 }
\ No newline at end of file
@@ -0,0 +1,482 @@
+#include "sim_usb_session.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lv_drivers/indev/keyboard.h"
+#include "usb_api.h"
+
+#define SIM_SESSION_START_OF_HEADER 0x55
+#define SIM_SESSION_CHUNK_NO_INDEX 4
+#define SIM_SESSION_CHUNK_COUNT_INDEX 6
+#define SIM_SESSION_SEQ_NO_INDEX 8
+#define SIM_SESSION_PKT_TYPE_INDEX 10
+
+/* Packet types of the host protocol; @see comm_packet_type in usb_internals.c
+ */
+#define SIM_SESSION_PKT_STATUS_REQ 1
+#define SIM_SESSION_PKT_CMD 2
+#define SIM_SESSION_PKT_OUT_REQ 3
+#define SIM_SESSION_PKT_STATUS_ACK 4
+#define SIM_SESSION_PKT_OUT_RESP 6
+
+#define SIM_SESSION_QUEUE_LEN 64
+#define SIM_SESSION_POLL_US 50
+#define SIM_SESSION_RESPONSE_TIMEOUT_US (30 * 1000 * 1000ULL)
+
+typedef struct {
+  uint32_t items[SIM_SESSION_QUEUE_LEN];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+} sim_session_queue_t;
+
+typedef struct {
+  bool active;
+  uint32_t index;
+  uint16_t seq_no;
+  uint32_t cmd_bytes;
+  uint32_t resp_bytes;
+  uint64_t cmd_first_us;
+  uint64_t cmd_last_us;
+  uint64_t out_req_us;
+  uint64_t out_first_us;
+  uint64_t ui_wait_us;
+} sim_session_query_t;
+
+static pthread_mutex_t session_lock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *record_file = NULL;
+static FILE *report_file = NULL;
+static sim_session_event_t *events = NULL;
+static uint32_t event_count = 0;
+static volatile bool replaying = false;
+static uint64_t session_start_us = 0;
+
+static volatile uint32_t device_write_count = 0;
+static volatile uint8_t last_device_pkt_type = 0;
+
+static sim_session_queue_t key_queue = {0};
+static sim_session_queue_t card_queue = {0};
+
+static volatile bool ui_waiting = false;
+static uint64_t ui_wait_start_us = 0;
+
+static sim_session_query_t query = {0};
+static uint32_t query_count = 0;
+
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static uint16_t read_be16(const uint8_t *data) {
+  return ((uint16_t)data[0] << 8) | data[1];
+}
+
+static bool is_protocol_packet(const uint8_t *data, uint32_t len) {
+  return len >= COMM_HEADER_SIZE && data[0] == SIM_SESSION_START_OF_HEADER &&
+         data[1] == SIM_SESSION_START_OF_HEADER;
+}
+
+static bool queue_push(sim_session_queue_t *queue, uint32_t item) {
+  uint32_t next = (queue->head + 1) % SIM_SESSION_QUEUE_LEN;
+  if (next == __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE))
+    return false;
+  queue->items[queue->head] = item;
+  __atomic_store_n(&queue->head, next, __ATOMIC_RELEASE);
+  return true;
+}
+
+static bool queue_pop(sim_session_queue_t *queue, uint32_t *item) {
+  uint32_t tail = queue->tail;
+  if (tail == __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE))
+    return false;
+  *item = queue->items[tail];
+  __atomic_store_n(
+      &queue->tail, (tail + 1) % SIM_SESSION_QUEUE_LEN, __ATOMIC_RELEASE);
+  return true;
+}
+
+static void record_event(sim_session_event_t *event) {
+  char line[SIM_SESSION_LINE_LEN];
+
+  if (NULL == record_file)
+    return;
+  event->time_us = now_us() - session_start_us;
+  if (sim_session_format_event(event, line, sizeof(line))) {
+    fputs(line, record_file);
+    fflush(record_file);
+  }
+}
+
+static void record_packet(char type, const uint8_t *data, uint32_t len) {
+  sim_session_event_t event = {.type = type};
+
+  if (NULL == record_file)
+    return;
+  event.len = (len < SIM_SESSION_PKT_MAX_LEN) ? len : SIM_SESSION_PKT_MAX_LEN;
+  memcpy(event.data, data, event.len);
+  record_event(&event);
+}
+
+static void record_value(char type, uint32_t value) {
+  sim_session_event_t event = {.type = type, .value = value};
+  record_event(&event);
+}
+
+static void report_query(const sim_session_query_t *q, uint64_t out_last_us) {
+  uint64_t transport_us =
+      (q->cmd_last_us - q->cmd_first_us) + (out_last_us - q->out_first_us);
+  uint64_t device_us = q->out_first_us - q->cmd_last_us;
+  uint64_t processing_us =
+      device_us > q->ui_wait_us ? device_us - q->ui_wait_us : 0;
+
+  if (NULL == report_file)
+    return;
+  fprintf(report_file,
+          "%u,%u,%u,%u,%llu,%llu,%llu,%llu\n",
+          q->index,
+          q->seq_no,
+          q->cmd_bytes,
+          q->resp_bytes,
+          (unsigned long long)(out_last_us - q->cmd_first_us),
+          (unsigned long long)transport_us,
+          (unsigned long long)processing_us,
+          (unsigned long long)q->ui_wait_us);
+  fflush(report_file);
+}
+
+static bool load_session(const char *path) {
+  char line[SIM_SESSION_LINE_LEN];
+  uint32_t capacity = 0;
+  FILE *file = fopen(path, "r");
+
+  if (NULL == file) {
+    perror("ERROR (session replay)");
+    return false;
+  }
+
+  while (NULL != fgets(line, sizeof(line), file)) {
+    sim_session_event_t event = {0};
+
+    if (!sim_session_parse_event(line, &event))
+      continue;
+
+    if (event_count == capacity) {
+      capacity = (0 == capacity) ? 256 : 2 * capacity;
+      sim_session_event_t *resized =
+          realloc(events, capacity * sizeof(sim_session_event_t));
+      if (NULL == resized) {
+        fclose(file);
+        return false;
+      }
+      events = resized;
+    }
+    events[event_count++] = event;
+  }
+
+  fclose(file);
+  return true;
+}
+
+/* Returns the packet type of the device response recorded after the host
+ * packet at index, or 0 if there is none. */
+static uint8_t recorded_response_type(uint32_t index) {
+  for (uint32_t i = index + 1; i < event_count; i++) {
+    if (SIM_SESSION_HOST_PACKET == events[i].type)
+      return 0;
+    if (SIM_SESSION_DEVICE_PACKET == events[i].type &&
+        is_protocol_packet(events[i].data, events[i].len))
+      return events[i].data[SIM_SESSION_PKT_TYPE_INDEX];
+  }
+  return 0;
+}
+
+static bool wait_for_response(uint32_t count) {
+  uint64_t start = now_us();
+  while (__atomic_load_n(&device_write_count, __ATOMIC_ACQUIRE) == count) {
+    if (now_us() - start > SIM_SESSION_RESPONSE_TIMEOUT_US)
+      return false;
+    usleep(SIM_SESSION_POLL_US);
+  }
+  return true;
+}
+
+static void replay_host_packet(uint32_t index,
+                               void (*inject)(const uint8_t *data,
+                                              uint32_t len)) {
+  const sim_session_event_t *event = &events[index];
+  bool is_out_req = is_protocol_packet(event->data, event->len) &&
+                    SIM_SESSION_PKT_OUT_REQ ==
+                        event->data[SIM_SESSION_PKT_TYPE_INDEX];
+  bool expect_output =
+      is_out_req && SIM_SESSION_PKT_OUT_RESP == recorded_response_type(index);
+
+  do {
+    uint32_t count = __atomic_load_n(&device_write_count, __ATOMIC_ACQUIRE);
+    inject(event->data, event->len);
+    if (!wait_for_response(count)) {
+      fprintf(
+          stderr, "WARN (session replay): no response to event %u\n", index);
+      return;
+    }
+  } while (expect_output &&
+           SIM_SESSION_PKT_STATUS_ACK == last_device_pkt_type);
+}
+
+bool sim_session_format_event(const sim_session_event_t *event,
+                              char *line,
+                              size_t len) {
+  char arg[2 * SIM_SESSION_PKT_MAX_LEN + 1] = "";
+  int written = 0;
+
+  switch (event->type) {
+    case SIM_SESSION_HOST_PACKET:
+    case SIM_SESSION_DEVICE_PACKET:
+      if (0 == event->len || SIM_SESSION_PKT_MAX_LEN < event->len)
+        return false;
+      for (uint8_t i = 0; i < event->len; i++)
+        snprintf(arg + 2 * i, 3, "%02X", event->data[i]);
+      break;
+    case SIM_SESSION_KEY_PRESS:
+    case SIM_SESSION_CARD_TAP:
+      snprintf(arg, sizeof(arg), "%u", (unsigned int)event->value);
+      break;
+    default:
+      return false;
+  }
+
+  written = snprintf(line,
+                     len,
+                     "%c %llu %s\n",
+                     event->type,
+                     (unsigned long long)event->time_us,
+                     arg);
+  return 0 < written && (size_t)written < len;
+}
+
+bool sim_session_parse_event(const char *line, sim_session_event_t *event) {
+  char arg[SIM_SESSION_LINE_LEN];
+  unsigned long long time = 0;
+
+  memset(event, 0, sizeof(*event));
+  if ('#' == line[0] ||
+      3 != sscanf(line, " %c %llu %511s", &event->type, &time, arg))
+    return false;
+  event->time_us = time;
+
+  switch (event->type) {
+    case SIM_SESSION_HOST_PACKET:
+    case SIM_SESSION_DEVICE_PACKET:
+      for (size_t i = 0;
+           i + 1 < strlen(arg) && event->len < SIM_SESSION_PKT_MAX_LEN;
+           i += 2) {
+        unsigned int byte = 0;
+        sscanf(arg + i, "%2x", &byte);
+        event->data[event->len++] = (uint8_t)byte;
+      }
+      return true;
+    case SIM_SESSION_KEY_PRESS:
+    case SIM_SESSION_CARD_TAP:
+      event->value = strtoul(arg, NULL, 0);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool sim_session_init(void) {
+  const char *record_path = getenv(SIM_SESSION_RECORD_ENV_VAR);
+  const char *replay_path = getenv(SIM_SESSION_REPLAY_ENV_VAR);
+  const char *report_path = getenv(SIM_SESSION_REPORT_ENV_VAR);
+
+  session_start_us = now_us();
+
+  if (NULL != record_path) {
+    record_file = fopen(record_path, "w");
+    if (NULL == record_file)
+      perror("ERROR (session record)");
+    else
+      fprintf(record_file, "# cypherock simulator session v1\n");
+  }
+
+  if (NULL != replay_path && load_session(replay_path))
+    replaying = true;
+
+  // Latency report is only produced for recorded or replayed sessions
+  if (NULL == record_file && !replaying)
+    return false;
+
+  report_file = stdout;
+  if (NULL != report_path && NULL == (report_file = fopen(report_path, "w"))) {
+    perror("ERROR (session report)");
+    report_file = stdout;
+  }
+  fprintf(report_file,
+          "query,seq,cmd_bytes,resp_bytes,total_us,transport_us,processing_"
+          "us,ui_wait_us\n");
+  return replaying;
+}
+
+bool sim_session_is_replaying(void) {
+  return replaying;
+}
+
+void sim_session_replay(void (*inject)(const uint8_t *data, uint32_t len)) {
+  uint64_t start = now_us();
+
+  for (uint32_t i = 0; i < event_count; i++) {
+    const sim_session_event_t *event = &events[i];
+    switch (event->type) {
+      case SIM_SESSION_HOST_PACKET:
+        // Status polling is replaced by re-requesting the output until ready
+        if (is_protocol_packet(event->data, event->len) &&
+            SIM_SESSION_PKT_STATUS_REQ ==
+                event->data[SIM_SESSION_PKT_TYPE_INDEX])
+          break;
+        replay_host_packet(i, inject);
+        break;
+      case SIM_SESSION_KEY_PRESS:
+        while (!queue_push(&key_queue, event->value))
+          usleep(SIM_SESSION_POLL_US);
+        break;
+      case SIM_SESSION_CARD_TAP:
+        while (!queue_push(&card_queue, event->value))
+          usleep(SIM_SESSION_POLL_US);
+        break;
+      default:
+        break;
+    }
+  }
+
+  fprintf(report_file,
+          "# replayed %u events, %u queries in %llu us\n",
+          event_count,
+          query_count,
+          (unsigned long long)(now_us() - start));
+  fflush(report_file);
+  replaying = false;
+  free(events);
+  events = NULL;
+
+  // The SDL thread cleans up the display and exits the simulator on quit
+  SDL_Event quit = {.type = SDL_QUIT};
+  SDL_PushEvent(&quit);
+}
+
+void sim_session_on_host_packet(const uint8_t *data, uint32_t len) {
+  uint64_t now = now_us();
+
+  pthread_mutex_lock(&session_lock);
+  record_packet(SIM_SESSION_HOST_PACKET, data, len);
+
+  if (is_protocol_packet(data, len)) {
+    uint8_t type = data[SIM_SESSION_PKT_TYPE_INDEX];
+    uint16_t chunk = read_be16(data + SIM_SESSION_CHUNK_NO_INDEX);
+    uint16_t seq_no = read_be16(data + SIM_SESSION_SEQ_NO_INDEX);
+
+    if (SIM_SESSION_PKT_CMD == type) {
+      if (1 == chunk) {
+        memset(&query, 0, sizeof(query));
+        query.active = true;
+        query.index = ++query_count;
+        query.seq_no = seq_no;
+        query.cmd_first_us = now;
+      }
+      query.cmd_bytes += data[DATA_SIZE_INDEX];
+      query.cmd_last_us = now;
+    } else if (SIM_SESSION_PKT_OUT_REQ == type && query.active &&
+               seq_no == query.seq_no) {
+      query.out_req_us = now;
+    }
+  }
+  pthread_mutex_unlock(&session_lock);
+}
+
+void sim_session_on_device_packet(const uint8_t *data, uint32_t len) {
+  uint64_t now = now_us();
+
+  pthread_mutex_lock(&session_lock);
+  record_packet(SIM_SESSION_DEVICE_PACKET, data, len);
+
+  if (is_protocol_packet(data, len)) {
+    uint8_t type = data[SIM_SESSION_PKT_TYPE_INDEX];
+    last_device_pkt_type = type;
+
+    if (SIM_SESSION_PKT_OUT_RESP == type && query.active) {
+      if (0 == query.resp_bytes)
+        query.out_first_us = query.out_req_us;
+      query.resp_bytes += data[DATA_SIZE_INDEX];
+      if (read_be16(data + SIM_SESSION_CHUNK_NO_INDEX) ==
+          read_be16(data + SIM_SESSION_CHUNK_COUNT_INDEX)) {
+        report_query(&query, now);
+        query.active = false;
+      }
+    }
+  } else {
+    last_device_pkt_type = 0;
+  }
+  pthread_mutex_unlock(&session_lock);
+
+  __atomic_add_fetch(&device_write_count, 1, __ATOMIC_RELEASE);
+}
+
+void sim_session_ui_wait_begin(void) {
+  ui_wait_start_us = now_us();
+  ui_waiting = true;
+}
+
+void sim_session_ui_wait_end(void) {
+  uint64_t elapsed = now_us() - ui_wait_start_us;
+
+  ui_waiting = false;
+  pthread_mutex_lock(&session_lock);
+  if (query.active)
+    query.ui_wait_us += elapsed;
+  pthread_mutex_unlock(&session_lock);
+}
+
+bool sim_session_keyboard_read(lv_indev_drv_t *indev_drv,
+                               lv_indev_data_t *data) {
+  static lv_indev_state_t prev_state = LV_INDEV_STATE_REL;
+  static bool script_pressed = false;
+  static uint32_t script_key = 0;
+
+  keyboard_read(indev_drv, data);
+  if (LV_INDEV_STATE_PR == data->state && LV_INDEV_STATE_PR != prev_state) {
+    pthread_mutex_lock(&session_lock);
+    record_value(SIM_SESSION_KEY_PRESS, data->key);
+    pthread_mutex_unlock(&session_lock);
+  }
+  prev_state = data->state;
+
+  if (!replaying)
+    return false;
+
+  // Scripted keys are pressed for one read and released on the next
+  if (script_pressed) {
+    data->state = LV_INDEV_STATE_REL;
+    data->key = script_key;
+    script_pressed = false;
+  } else if (ui_waiting && queue_pop(&key_queue, &script_key)) {
+    data->state = LV_INDEV_STATE_PR;
+    data->key = script_key;
+    script_pressed = true;
+  }
+  return false;
+}
+
+void sim_session_on_card_tap(uint8_t *card_number) {
+  uint32_t scripted = 0;
+
+  if (replaying && queue_pop(&card_queue, &scripted))
+    *card_number = (uint8_t)scripted;
+
+  pthread_mutex_lock(&session_lock);
+  record_value(SIM_SESSION_CARD_TAP, *card_number);
+  pthread_mutex_unlock(&session_lock);
+}
@@ -0,0 +1,124 @@
+#ifndef __SIM_USB_SESSION_HEADER__
+#define __SIM_USB_SESSION_HEADER__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+/* Session recording & replay for the simulator.
+ *
+ * CY_SIM_RECORD=<file>  Record the packet-level USB conversation, joystick
+ *                       presses and card taps of this run into <file>.
+ * CY_SIM_REPLAY=<file>  Replay a recorded session at maximum speed. Host
+ *                       packets are injected in lock-step with the device
+ *                       responses, key presses are delivered whenever the
+ *                       firmware waits for UI input and card taps select the
+ *                       recorded card.
+ * CY_SIM_REPORT=<file>  Destination of the per-query latency report (CSV).
+ *                       Defaults to stdout.
+ *
+ * Session file format (text, one event per line, times in microseconds since
+ * the start of the session):
+ *   H <time> <hex>   packet sent by the host to the device
+ *   D <time> <hex>   packet sent by the device to the host
+ *   K <time> <key>   joystick press (LVGL key code)
+ *   C <time> <card>  card tap with card number 1-4
+ * Empty lines and lines starting with '#' are ignored. */
+#define SIM_SESSION_RECORD_ENV_VAR "CY_SIM_RECORD"
+#define SIM_SESSION_REPLAY_ENV_VAR "CY_SIM_REPLAY"
+#define SIM_SESSION_REPORT_ENV_VAR "CY_SIM_REPORT"
+
+typedef enum {
+  SIM_SESSION_HOST_PACKET = 'H',
+  SIM_SESSION_DEVICE_PACKET = 'D',
+  SIM_SESSION_KEY_PRESS = 'K',
+  SIM_SESSION_CARD_TAP = 'C',
+} sim_session_event_e;
+
+#define SIM_SESSION_PKT_MAX_LEN 64
+#define SIM_SESSION_LINE_LEN 512
+
+/* One line of a session file */
+typedef struct {
+  char type;    ///< @see sim_session_event_e
+  uint8_t len;
+  uint8_t data[SIM_SESSION_PKT_MAX_LEN];    ///< Packet of H and D events
+  uint32_t value;                           ///< Key code or card number
+  uint64_t time_us;
+} sim_session_event_t;
+
+/**
+ * @brief Reads the session configuration from the environment and opens the
+ * record/replay/report files.
+ *
+ * @return true if a recorded session is to be replayed, false otherwise
+ */
+bool sim_session_init(void);
+
+/**
+ * @brief Formats an event as one line of a session file, newline included
+ *
+ * @return true if the event is valid and fits in len bytes, false otherwise
+ */
+bool sim_session_format_event(const sim_session_event_t *event,
+                              char *line,
+                              size_t len);
+
+/**
+ * @brief Parses one line of a session file
+ *
+ * @return true if the line holds an event, false for comments, empty lines
+ * and unknown events
+ */
+bool sim_session_parse_event(const char *line, sim_session_event_t *event);
+
+/**
+ * @brief Returns true while a recorded session is being replayed
+ */
+bool sim_session_is_replaying(void);
+
+/**
+ * @brief Entry point of the replay thread. Injects the recorded host packets
+ * through inject() and, once the session is exhausted, posts a quit event so
+ * that the simulator shuts down from its SDL thread.
+ *
+ * @param inject Callback delivering a host packet to the USB receive path
+ */
+void sim_session_replay(void (*inject)(const uint8_t *data, uint32_t len));
+
+/**
+ * @brief Notifies the session of a packet received from the host
+ */
+void sim_session_on_host_packet(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Notifies the session of a packet written to the host
+ */
+void sim_session_on_device_packet(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Marks the start/end of a period where the firmware is blocked on user
+ * input. Used for the UI-wait column of the latency report and to pace the
+ * scripted key presses.
+ */
+void sim_session_ui_wait_begin(void);
+void sim_session_ui_wait_end(void);
+
+/**
+ * @brief Keypad read callback wrapping the SDL keyboard driver. Records key
+ * presses and injects scripted ones during replay.
+ */
+bool sim_session_keyboard_read(lv_indev_drv_t *indev_drv,
+                               lv_indev_data_t *data);
+
+/**
+ * @brief Returns the card to be presented for the next card tap
+ *
+ * @param card_number Updated with the scripted card number during replay;
+ * otherwise left untouched
+ */
+void sim_session_on_card_tap(uint8_t *card_number);
+
+#endif
@@ -1,9 +1,14 @@
 #include "applet.h"
 
 #include <errno.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "sim_instance.h"
+#include "sim_usb_session.h"
+
 #define PN532_FILE "applet_comm.bin"
 
 #define MAX_BUFFER_LEN 270
@@ -11,8 +16,27 @@
 #define MAX_WALLETS 4
 
 #define APDU_BASE_OFFSET 8
-
-#define CARD_FILE_NAME "sim_cards.bin"
+// Frame length byte covers the TFI, the InDataExchange command and the target
+#define APDU_LEN_OFFSET 3
+#define APDU_LEN_OVERHEAD 3
+
+// Reassembled command or response, including the secure channel overhead
+#define MAX_MSG_LEN 600
+// Largest C-APDU data per frame advertised in TAG_CARD_CAPABILITIES
+#define SIM_MAX_FRAME_LEN 240
+// Response data per frame of a whole-message protected response; kept small
+// so that long responses are chained like on cards with a small frame size
+#define SIM_RESP_FRAME_LEN 128
+
+#define CLA_CHAIN_FIRST 0x10
+#define CLA_CHAIN_MIDDLE 0x80
+#define INS_GET_RESPONSE 0xCF
+#define DEVICE_KEY_ID_LEN 4
+#define SC_BLOCK_LEN 16
+
+// CLA, INS, P1, P2, Lc, name TLV (18 bytes) and password TLV (34 bytes)
+#define FIELD_MASK_OFFSET 57
+#define FIELD_SELECTED(mask, tag) (((mask)&WALLET_FIELD(tag)) != 0)
 
 typedef struct _wallet {
   uint8_t is_set;
@@ -36,16 +60,31 @@ typedef struct {
   SimWallet wallets[MAX_WALLETS];
 } SimCard;
 
+typedef struct {
+  bool enabled;
+  uint8_t enc_key[32];
+  uint8_t mac_key[32];
+  uint8_t iv[SC_BLOCK_LEN];
+} SimSecureChannel;
+
 static SimCard cards[MAX_CARDS];
+static SimSecureChannel secure_channel;
+static bool selective_retrieve = true;
+static uint8_t cmd_msg[MAX_MSG_LEN];
+static uint16_t cmd_msg_len = 0;
+static uint8_t resp_msg[MAX_MSG_LEN];
+static uint16_t resp_msg_len = 0;
+static uint16_t resp_msg_off = 0;
+static uint16_t resp_frame_len = MAX_MSG_LEN;
 static uint8_t family_id[5] = {0xa1, 0xa2, 0xa3, 0xa4, 0x00};
 static uint8_t card_number = 1;
-static uint8_t version[6] = {0x01, 0x04, 0x01, 0x02, 0x03, 0x04};
+static uint8_t version[6] = {0x30, 0x04, 0x01, 0x02, 0x03, 0x04};
 
 static uint8_t applet_select_apdu[] =
     {0x00, 0xa4, 0x04, 0x00, 0x05, 0x01, 0x02, 0x03, 0x04, 0x05};
 static uint8_t applet_select_resp[] = {0xb0,
                                        0x06,
-                                       0x01,
+                                       0x30,
                                        0x04,
                                        0x01,
                                        0x02,
@@ -64,20 +103,30 @@ static int add_wallet(uint8_t id, uint8_t *buffer);
 static int retrieve_wallet(uint8_t *buffer, uint8_t *out_buffer, uint16_t *len);
 static int delete_wallet(uint8_t *buffer);
 static void process();
+static uint16_t dispatch(uint8_t *apdu, uint8_t *out_buffer);
+static bool collect_command(const uint8_t *apdu, uint16_t len);
+static bool unprotect_command();
+static uint16_t protect_response(uint16_t len);
+static void send_next_frame();
 static uint8_t adafruit_pn532_cs_complement_calc(uint8_t current_sum);
 static void write_response(uint8_t *p_cmd, uint8_t cmd_len);
 static uint8_t prepare_wallet_list(uint8_t *buffer);
 
+static FILE *open_file(const char *file_name, const char *mode) {
+  char path[SIM_INSTANCE_MAX_PATH_LEN];
+  return fopen(sim_instance_path(NULL, file_name, path, sizeof(path)), mode);
+}
+
 static void init_cards() {
-  FILE *file = fopen(CARD_FILE_NAME, "rb");
+  FILE *file = open_file(CARD_FILE_NAME, "rb");
   errno = 0;
   if (!file) {
-    file = fopen(CARD_FILE_NAME, "wb");
+    file = open_file(CARD_FILE_NAME, "wb");
     if (!file)
       return;
     fwrite(&cards, 1, sizeof(cards), file);
   } else {
-    file = fopen(CARD_FILE_NAME, "rb");
+    file = open_file(CARD_FILE_NAME, "rb");
     if (!file)
       return;
     fread(&cards, 1, sizeof(cards), file);
@@ -88,7 +137,7 @@ static void init_cards() {
 }
 
 static void save() {
-  FILE *file = fopen(CARD_FILE_NAME, "wb");
+  FILE *file = open_file(CARD_FILE_NAME, "wb");
   if (!file)
     return;
   fwrite(&cards, 1, sizeof(cards), file);
@@ -98,7 +147,7 @@ static void save() {
 }
 
 ret_code_t applet_read(uint8_t *buffer, uint8_t size) {
-  FILE *file = fopen(PN532_FILE, "rb");
+  FILE *file = open_file(PN532_FILE, "rb");
   if (!file)
     return STM_ERROR_INTERNAL;
   errno = 0;
@@ -113,7 +162,7 @@ ret_code_t applet_read(uint8_t *buffer, uint8_t size) {
 
 ret_code_t applet_write(uint8_t *buffer, uint8_t size) {
   init_cards();
-  FILE *file = fopen(PN532_FILE, "wb");
+  FILE *file = open_file(PN532_FILE, "wb");
   if (!file)
     return STM_ERROR_INTERNAL;
   errno = 0;
@@ -128,26 +177,68 @@ ret_code_t applet_write(uint8_t *buffer, uint8_t size) {
   return STM_SUCCESS;
 }
 
+void applet_enable_secure_channel(const uint8_t enc_key[32],
+                                  const uint8_t mac_key[32]) {
+  memcpy(secure_channel.enc_key, enc_key, sizeof(secure_channel.enc_key));
+  memcpy(secure_channel.mac_key, mac_key, sizeof(secure_channel.mac_key));
+  secure_channel.enabled = true;
+}
+
+void applet_set_selective_retrieve(bool enabled) {
+  selective_retrieve = enabled;
+}
+
 static void process() {
-  family_id[4] = card_number;
   uint8_t buffer[MAX_BUFFER_LEN];
-  uint8_t out_buffer[MAX_BUFFER_LEN];
-  uint16_t off = 0, id, response;
+  uint8_t *apdu = buffer + APDU_BASE_OFFSET;
+  bool whole_msg = false;
 
-  FILE *file = fopen(PN532_FILE, "rb");
+  FILE *file = open_file(PN532_FILE, "rb");
   if (!file)
     return;
   errno = 0;
-  uint16_t len = fread(buffer, MAX_BUFFER_LEN, 1, file);
+  fread(buffer, MAX_BUFFER_LEN, 1, file);
   fclose(file);
   if (errno) {
     perror("");
     return;
   }
 
-  switch (buffer[APDU_BASE_OFFSET + OFFSET_INS]) {
+  whole_msg = (apdu[OFFSET_CLA] & CLA_WHOLE_MSG_SC) != 0;
+  if (whole_msg && apdu[OFFSET_INS] == INS_GET_RESPONSE) {
+    send_next_frame();
+    return;
+  }
+
+  if (!collect_command(apdu, buffer[APDU_LEN_OFFSET] - APDU_LEN_OVERHEAD)) {
+    // more fragments follow; report the space left for them
+    uint8_t ack[] = {0x90, 0xFF};
+    write_response(ack, sizeof(ack));
+    return;
+  }
+
+  if (whole_msg && !unprotect_command()) {
+    resp_msg[0] = 0x69;
+    resp_msg[1] = 0x82;
+    resp_msg_len = 2;
+  } else {
+    resp_msg_len = dispatch(cmd_msg, resp_msg);
+    if (whole_msg)
+      resp_msg_len = protect_response(resp_msg_len);
+  }
+  cmd_msg_len = 0;
+  resp_msg_off = 0;
+  resp_frame_len = whole_msg ? SIM_RESP_FRAME_LEN : MAX_MSG_LEN;
+  send_next_frame();
+}
+
+static uint16_t dispatch(uint8_t *apdu, uint8_t *out_buffer) {
+  family_id[4] = card_number;
+  uint16_t off = 0, id, response;
+
+  switch (apdu[OFFSET_INS]) {
     case 0xa4:    // applet select
-      if (memcmp(buffer + APDU_BASE_OFFSET + OFFSET_CLA,
+      if (memcmp(apdu + OFFSET_CLA,
                  applet_select_apdu,
                  sizeof(applet_select_apdu)) != 0) {
         off = 0;
@@ -156,8 +247,22 @@ static void process() {
         break;
       }
       card_number = (card_number % MAX_CARDS) + 1;
-      memcpy(out_buffer, applet_select_resp, sizeof(applet_select_resp));
-      off = sizeof(applet_select_resp);
+      sim_session_on_card_tap(&card_number);
+      // a new session starts with a fresh IV for the secure channel
+      for (int i = 0; i < SC_BLOCK_LEN; i++)
+        secure_channel.iv[i] = rand() & 0xFF;
+      out_buffer[off++] = TAG_CARD_IV;
+      out_buffer[off++] = SC_BLOCK_LEN;
+      memcpy(out_buffer + off, secure_channel.iv, SC_BLOCK_LEN);
+      off += SC_BLOCK_LEN;
+      out_buffer[off++] = TAG_CARD_CAPABILITIES;
+      out_buffer[off++] = 2;
+      out_buffer[off++] =
+          CARD_CAP_WHOLE_MSG_SC |
+          (selective_retrieve ? CARD_CAP_SELECTIVE_RETRIEVE : 0);
+      out_buffer[off++] = SIM_MAX_FRAME_LEN;
+      memcpy(out_buffer + off, applet_select_resp, sizeof(applet_select_resp));
+      off += sizeof(applet_select_resp);
       out_buffer[off - 1] = card_number;    // put correct number as this
                                             // program cycles b/w 1-4 cards
       out_buffer[off++] = 0x90;
@@ -171,20 +276,20 @@ static void process() {
         out_buffer[off++] = 0x6a;
         out_buffer[off++] = 0x84;
       } else {
-        response = add_wallet(id, buffer + APDU_BASE_OFFSET);
+        response = add_wallet(id, apdu);
         out_buffer[off++] = ((response >> 8) & 0x00ff);
         out_buffer[off++] = (response & 0x00ff);
       }
       break;
 
     case 0xc2:    // retrieve wallet
-      response = retrieve_wallet(buffer + APDU_BASE_OFFSET, out_buffer, &off);
+      response = retrieve_wallet(apdu, out_buffer, &off);
       out_buffer[off++] = ((response >> 8) & 0x00ff);
       out_buffer[off++] = (response & 0x00ff);
       break;
 
     case 0xc3:    // delete wallet
-      response = delete_wallet(buffer + APDU_BASE_OFFSET);
+      response = delete_wallet(apdu);
       out_buffer[off++] = ((response >> 8) & 0x00ff);
       out_buffer[off++] = (response & 0x00ff);
       break;
@@ -193,6 +298,7 @@ static void process() {
       off = prepare_wallet_list(out_buffer + 1);
       out_buffer[0] = off / 56;
       if (off) {
+        off++;    // the list follows the wallet count
         out_buffer[off++] = 0x90;
         out_buffer[off++] = 0x00;
       } else {
@@ -201,7 +307,141 @@ static void process() {
       }
       break;
   }
-  write_response(out_buffer, off);
+  return off;
+}
+
+/**
+ * Appends a fragment of a chained command (CLA bits 0x10 first, 0x80 middle,
+ * none for the last one) and returns true once the command is complete.
+ */
+static bool collect_command(const uint8_t *apdu, uint16_t len) {
+  const uint8_t chain = apdu[OFFSET_CLA] & (CLA_CHAIN_FIRST | CLA_CHAIN_MIDDLE);
+  uint16_t data_len = len > OFFSET_CDATA ? len - OFFSET_CDATA : 0;
+
+  if (0 == cmd_msg_len || CLA_CHAIN_FIRST == chain) {
+    memcpy(cmd_msg, apdu, len < OFFSET_CDATA ? len : OFFSET_CDATA);
+    cmd_msg_len = len < OFFSET_CDATA ? len : OFFSET_CDATA;
+  }
+  if (cmd_msg_len + data_len > sizeof(cmd_msg))
+    data_len = sizeof(cmd_msg) - cmd_msg_len;
+  memcpy(cmd_msg + cmd_msg_len, apdu + OFFSET_CDATA, data_len);
+  cmd_msg_len += data_len;
+  cmd_msg[OFFSET_CLA] = apdu[OFFSET_CLA];
+
+  return 0 == chain;
+}
+
+/**
+ * Verifies and decrypts a whole-message protected command in place. The data
+ * is MAC (16 bytes), AES-CBC ciphertext and the device key id; the MAC is the
+ * last block of the CBC encryption of the ciphertext under the MAC key.
+ */
+static bool unprotect_command() {
+  uint8_t *data = cmd_msg + OFFSET_CDATA;
+  uint16_t data_len = 0;
+  uint8_t mac[SC_BLOCK_LEN], iv[SC_BLOCK_LEN] = {0};
+  aes_encrypt_ctx enc_ctx = {0};
+  aes_decrypt_ctx dec_ctx = {0};
+
+  // without shared session keys the firmware data is used as it is
+  if (!secure_channel.enabled)
+    return true;
+  if (cmd_msg_len < OFFSET_CDATA + DEVICE_KEY_ID_LEN)
+    return false;
+  // commands without data carry only the device key id
+  data_len = cmd_msg_len - OFFSET_CDATA - DEVICE_KEY_ID_LEN;
+  if (0 == data_len)
+    return true;
+  if (data_len < 2 * SC_BLOCK_LEN || 0 != data_len % SC_BLOCK_LEN)
+    return false;
+
+  uint8_t payload[data_len - SC_BLOCK_LEN];
+  aes_encrypt_key256(secure_channel.mac_key, &enc_ctx);
+  aes_cbc_encrypt(data + SC_BLOCK_LEN, payload, sizeof(payload), iv, &enc_ctx);
+  if (0 != memcmp(payload + sizeof(payload) - SC_BLOCK_LEN, data, SC_BLOCK_LEN))
+    return false;
+
+  memcpy(mac, data, SC_BLOCK_LEN);
+  memcpy(payload, data + SC_BLOCK_LEN, sizeof(payload));
+  aes_decrypt_key256(secure_channel.enc_key, &dec_ctx);
+  aes_cbc_decrypt(payload, data, sizeof(payload), secure_channel.iv, &dec_ctx);
+  memcpy(secure_channel.iv, mac, SC_BLOCK_LEN);
+
+  data_len = sizeof(payload);
+  while (data_len > 0 && data[data_len - 1] == 0x00)
+    data_len--;
+  if (data_len > 0 && data[data_len - 1] == 0x80)
+    data_len--;
+  cmd_msg[OFFSET_LC] = data_len;
+  cmd_msg_len = OFFSET_CDATA + data_len;
+  return true;
+}
+
+/**
+ * Protects the response in resp_msg as a whole: MAC, ciphertext of the padded
+ * data and the plain status word. Returns the length of the protected
+ * response.
+ */
+static uint16_t protect_response(uint16_t len) {
+  // a bare status word is sent as it is
+  if (!secure_channel.enabled || len <= 2)
+    return len;
+
+  uint16_t data_len = len - 2;
+  uint8_t payload[(data_len / SC_BLOCK_LEN + 1) * SC_BLOCK_LEN];
+  uint8_t status_word[2] = {resp_msg[len - 2], resp_msg[len - 1]};
+  uint8_t iv[SC_BLOCK_LEN] = {0};
+  aes_encrypt_ctx ctx = {0};
+
+  memset(payload, 0, sizeof(payload));
+  memcpy(payload, resp_msg, data_len);
+  payload[data_len] = 0x80;
+  aes_encrypt_key256(secure_channel.enc_key, &ctx);
+  aes_cbc_encrypt(payload,
+                  resp_msg + SC_BLOCK_LEN,
+                  sizeof(payload),
+                  secure_channel.iv,
+                  &ctx);
+  aes_encrypt_key256(secure_channel.mac_key, &ctx);
+  aes_cbc_encrypt(
+      resp_msg + SC_BLOCK_LEN, payload, sizeof(payload), iv, &ctx);
+  memcpy(resp_msg, payload + sizeof(payload) - SC_BLOCK_LEN, SC_BLOCK_LEN);
+  memcpy(secure_channel.iv, resp_msg, SC_BLOCK_LEN);
+
+  len = SC_BLOCK_LEN + sizeof(payload);
+  resp_msg[len++] = status_word[0];
+  resp_msg[len++] = status_word[1];
+  return len;
+}
+
+/**
+ * Sends the next frame of the pending response. Frames followed by more data
+ * end with SW 0x61 and the remaining length, and the rest is served on
+ * GET RESPONSE (INS 0xCF).
+ */
+static void send_next_frame() {
+  uint8_t frame[SIM_RESP_FRAME_LEN + 2];
+  uint16_t remaining = resp_msg_len - resp_msg_off;
+
+  if (0 == resp_msg_len) {
+    frame[0] = 0x69;
+    frame[1] = 0x85;
+    write_response(frame, 2);
+    return;
+  }
+
+  if (remaining <= resp_frame_len + 2) {
+    write_response(resp_msg + resp_msg_off, remaining);
+    resp_msg_len = 0;
+    return;
+  }
+
+  memcpy(frame, resp_msg + resp_msg_off, resp_frame_len);
+  resp_msg_off += resp_frame_len;
+  remaining -= resp_frame_len;
+  frame[resp_frame_len] = 0x61;
+  frame[resp_frame_len + 1] = remaining > 0xFF ? 0x00 : remaining;
+  write_response(frame, resp_frame_len + 2);
 }
 
 static int get_available_slot() {
@@ -269,38 +509,77 @@ static int retrieve_wallet(uint8_t *buffer,
                            uint8_t *out_buffer,
                            uint16_t *len) {
   int id = find_wallet(buffer);
-  uint16_t size = 0;
+  uint16_t size = 0, mask = 0xFFFF;
   if (id < 0 || id > MAX_WALLETS)
     return 0x6a83;
 
+  // selective retrieve: field mask follows the name and password
+  if (buffer[OFFSET_P1] == P1_RETRIEVE_WALLET_SELECTED) {
+    if (!selective_retrieve)
+      return 0x6a86;
+    if (buffer[FIELD_MASK_OFFSET] != TAG_FIELD_MASK)
+      return 0x6a80;
+    mask = (buffer[FIELD_MASK_OFFSET + 2] << 8) | buffer[FIELD_MASK_OFFSET + 3];
+  }
+
   // prepare wallet
   SimWallet *wallet = &cards[card_number - 1].wallets[id];
-  out_buffer[size++] = 0xe2;
-  out_buffer[size++] = wallet->xcor;
-  out_buffer[size++] = 0xe3;
-  out_buffer[size++] = wallet->mnemonics_count;
-  out_buffer[size++] = 0xe4;
-  out_buffer[size++] = wallet->total_shares;
-  out_buffer[size++] = 0xe5;
-  out_buffer[size++] = sizeof(wallet->share);
-  memcpy(out_buffer + size, wallet->share, sizeof(wallet->share));
-  size += sizeof(wallet->share);
-  out_buffer[size++] = 0xe6;
-  out_buffer[size++] = sizeof(wallet->checksum);
-  memcpy(out_buffer + size, wallet->checksum, sizeof(wallet->checksum));
-  size += sizeof(wallet->checksum);
-  out_buffer[size++] = 0xe7;
-  out_buffer[size++] = wallet->min_shares;
-  out_buffer[size++] = 0xe8;
-  out_buffer[size++] = wallet->wallet_info;
-  out_buffer[size++] = 0xe9;
-  out_buffer[size++] = sizeof(wallet->key);
-  memcpy(out_buffer + size, wallet->key, sizeof(wallet->key));
-  size += sizeof(wallet->key);
-  out_buffer[size++] = 0xec;
-  out_buffer[size++] = sizeof(wallet->wallet_id);
-  memcpy(out_buffer + size, wallet->wallet_id, sizeof(wallet->wallet_id));
-  size += sizeof(wallet->wallet_id);
+  if (FIELD_SELECTED(mask, INS_xCor)) {
+    out_buffer[size++] = 0xe2;
+    out_buffer[size++] = wallet->xcor;
+  }
+  if (FIELD_SELECTED(mask, INS_NO_OF_MNEMONICS)) {
+    out_buffer[size++] = 0xe3;
+    out_buffer[size++] = wallet->mnemonics_count;
+  }
+  if (FIELD_SELECTED(mask, INS_TOTAL_NO_OF_SHARE)) {
+    out_buffer[size++] = 0xe4;
+    out_buffer[size++] = wallet->total_shares;
+  }
+  if (FIELD_SELECTED(mask, INS_WALLET_SHARE)) {
+    out_buffer[size++] = 0xe5;
+    out_buffer[size++] = sizeof(wallet->share);
+    memcpy(out_buffer + size, wallet->share, sizeof(wallet->share));
+    size += sizeof(wallet->share);
+  }
+  if (FIELD_SELECTED(mask, INS_STRUCTURE_CHECKSUM)) {
+    out_buffer[size++] = 0xe6;
+    out_buffer[size++] = sizeof(wallet->checksum);
+    memcpy(out_buffer + size, wallet->checksum, sizeof(wallet->checksum));
+    size += sizeof(wallet->checksum);
+  }
+  if (FIELD_SELECTED(mask, INS_MIN_NO_OF_SHARES)) {
+    out_buffer[size++] = 0xe7;
+    out_buffer[size++] = wallet->min_shares;
+  }
+  if (FIELD_SELECTED(mask, INS_WALLET_INFO)) {
+    out_buffer[size++] = 0xe8;
+    out_buffer[size++] = wallet->wallet_info;
+  }
+  if (FIELD_SELECTED(mask, INS_KEY)) {
+    out_buffer[size++] = 0xe9;
+    out_buffer[size++] = sizeof(wallet->key);
+    memcpy(out_buffer + size, wallet->key, sizeof(wallet->key));
+    size += sizeof(wallet->key);
+  }
+  if (FIELD_SELECTED(mask, INS_BENEFICIARY_KEY)) {
+    out_buffer[size++] = 0xea;
+    out_buffer[size++] = BENEFICIARY_KEY_SIZE;
+    memcpy(out_buffer + size, wallet->benef_key, BENEFICIARY_KEY_SIZE);
+    size += BENEFICIARY_KEY_SIZE;
+  }
+  if (FIELD_SELECTED(mask, INS_IV_FOR_BENEFICIARY_KEY)) {
+    out_buffer[size++] = 0xeb;
+    out_buffer[size++] = IV_FOR_BENEFICIARY_KEY_SIZE;
+    memcpy(out_buffer + size, wallet->benef_iv, IV_FOR_BENEFICIARY_KEY_SIZE);
+    size += IV_FOR_BENEFICIARY_KEY_SIZE;
+  }
+  if (FIELD_SELECTED(mask, INS_WALLET_ID)) {
+    out_buffer[size++] = 0xec;
+    out_buffer[size++] = sizeof(wallet->wallet_id);
+    memcpy(out_buffer + size, wallet->wallet_id, sizeof(wallet->wallet_id));
+    size += sizeof(wallet->wallet_id);
+  }
 
   if (len)
     *len = size;
@@ -370,7 +649,7 @@ static void write_response(uint8_t *p_cmd, uint8_t cmd_len) {
   buffer[HEADER_SEQUENCE_LENGTH + cmd_len + 2] = checksum;
   buffer[HEADER_SEQUENCE_LENGTH + cmd_len + 3] = PN532_POSTAMBLE;
 
-  FILE *file = fopen(PN532_FILE, "wb");
+  FILE *file = open_file(PN532_FILE, "wb");
   if (!file)
     return;
   errno = 0;
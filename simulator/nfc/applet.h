@@ -4,7 +4,22 @@
 #include "apdu.h"
 #include "board.h"
 
+/* Backing file of the emulated card database */
+#define CARD_FILE_NAME "sim_cards.bin"
+
 ret_code_t applet_read(uint8_t *buffer, uint8_t size);
 ret_code_t applet_write(uint8_t *buffer, uint8_t size);
 
+/* Shares session keys with the emulated card so that it can serve whole-message
+ * protected commands (CLA_WHOLE_MSG_SC); the simulator cannot pair with the
+ * device. The IV of the secure channel is advertised on applet select. */
+void applet_enable_secure_channel(const uint8_t enc_key[32],
+                                  const uint8_t mac_key[32]);
+
+/* Serves the field mask of retrieve wallet (CARD_CAP_SELECTIVE_RETRIEVE) when
+ * enabled, the default. Otherwise the emulated card acts like an older applet
+ * and rejects the selective P1; the capability advertised on applet select
+ * follows the setting at that time. */
+void applet_set_selective_retrieve(bool enabled);
+
 #endif
\ No newline at end of file
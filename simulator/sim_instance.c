@@ -0,0 +1,41 @@
+#include "sim_instance.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define SIM_PATH_SEPARATOR "\\"
+#else
+#define SIM_PATH_SEPARATOR "/"
+#endif
+
+static const char *get_env_or_empty(const char *name) {
+  const char *value = getenv(name);
+  return (NULL == value) ? "" : value;
+}
+
+const char *sim_instance_get_id(void) {
+  return get_env_or_empty(SIM_INSTANCE_ENV_VAR);
+}
+
+const char *sim_instance_path(const char *default_dir,
+                              const char *file_name,
+                              char *path,
+                              size_t path_len) {
+  const char *dir = get_env_or_empty(SIM_INSTANCE_DIR_ENV_VAR);
+  const char *id = sim_instance_get_id();
+
+  if ('\0' == dir[0]) {
+    dir = (NULL == default_dir) ? "" : default_dir;
+  }
+
+  snprintf(path,
+           path_len,
+           "%s%s%s%s%s",
+           dir,
+           ('\0' == dir[0]) ? "" : SIM_PATH_SEPARATOR,
+           id,
+           ('\0' == id[0]) ? "" : "_",
+           file_name);
+  return path;
+}
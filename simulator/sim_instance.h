@@ -0,0 +1,42 @@
+#ifndef __SIM_INSTANCE_HEADER__
+#define __SIM_INSTANCE_HEADER__
+
+#include <stddef.h>
+
+/* Environment variables that isolate one simulator instance from another. Set
+ * CY_SIM_INSTANCE to a short unique tag (e.g. "w3") and/or CY_SIM_DIR to a
+ * private directory; every backing file (flash, cards, PN532 channel and USB
+ * pipes) is then namespaced with them. When neither is set, the historic
+ * shared paths are used unchanged. */
+#define SIM_INSTANCE_ENV_VAR "CY_SIM_INSTANCE"
+#define SIM_INSTANCE_DIR_ENV_VAR "CY_SIM_DIR"
+
+#define SIM_INSTANCE_MAX_PATH_LEN 256
+
+/**
+ * @brief Returns the instance tag configured for this process
+ *
+ * @return const char* Instance tag, or an empty string for the default
+ * (shared) instance
+ */
+const char *sim_instance_get_id(void);
+
+/**
+ * @brief Resolves the per-instance path of a simulator backing file
+ * @details The directory is CY_SIM_DIR when set, otherwise default_dir (NULL
+ * or empty means the current working directory). When an instance tag is set
+ * the file name is prefixed with "<tag>_".
+ *
+ * @param default_dir Directory used when CY_SIM_DIR is not set
+ * @param file_name Base name of the backing file
+ * @param path Output buffer for the resolved path
+ * @param path_len Size of the output buffer
+ *
+ * @return const char* path, for convenience in fopen calls
+ */
+const char *sim_instance_path(const char *default_dir,
+                              const char *file_name,
+                              char *path,
+                              size_t path_len);
+
+#endif
@@ -0,0 +1,208 @@
+#include "sim_snapshot.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "applet.h"
+#include "flash.h"
+#include "rand.h"
+#include "sim_instance.h"
+
+#define SIM_SNAPSHOT_MAGIC "CYSIMSNP"
+#define SIM_SNAPSHOT_VERSION 1
+#define SIM_SNAPSHOT_NAME_LEN 32
+#define SIM_SNAPSHOT_CHUNK_LEN 4096
+
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t rng_seed;
+  uint32_t file_count;
+} sim_snapshot_header_t;
+
+typedef struct {
+  char name[SIM_SNAPSHOT_NAME_LEN];
+  uint32_t size;
+} sim_snapshot_entry_t;
+
+/* Backing files making up the persistent state of the device */
+static const char *const snapshot_files[] = {
+    DATA_FILE_NAME,
+    LOG_FILE_NAME,
+    PERM_DATA_FILE_NAME,
+    FW_DATA_FILE_NAME,
+    CARD_FILE_NAME,
+};
+
+#define SIM_SNAPSHOT_FILE_COUNT                                                \
+  (sizeof(snapshot_files) / sizeof(snapshot_files[0]))
+
+static const char *save_path = NULL;
+
+static FILE *open_file(const char *file_name, const char *mode) {
+  char path[SIM_INSTANCE_MAX_PATH_LEN];
+  return fopen(sim_instance_path(NULL, file_name, path, sizeof(path)), mode);
+}
+
+static void seed_rng(uint32_t seed) {
+  // BSP_RNG_Generate() draws from rand(); the crypto library has its own
+  srand(seed);
+  random_reseed(seed);
+}
+
+static bool copy_bytes(FILE *src, FILE *dst, uint32_t size) {
+  uint8_t chunk[SIM_SNAPSHOT_CHUNK_LEN];
+
+  while (size > 0) {
+    size_t len = (size < sizeof(chunk)) ? size : sizeof(chunk);
+    if (fread(chunk, 1, len, src) != len || fwrite(chunk, 1, len, dst) != len)
+      return false;
+    size -= len;
+  }
+  return true;
+}
+
+static bool is_snapshot_file(const char *name) {
+  for (size_t i = 0; i < SIM_SNAPSHOT_FILE_COUNT; i++) {
+    if (0 == strcmp(name, snapshot_files[i]))
+      return true;
+  }
+  return false;
+}
+
+static bool save_file(FILE *snapshot, const char *name, uint32_t *count) {
+  sim_snapshot_entry_t entry = {0};
+  FILE *file = open_file(name, "rb");
+  long size = 0;
+  bool status = false;
+
+  // Files not created yet are omitted; they are recreated blank on restore
+  if (NULL == file)
+    return true;
+
+  if (0 == fseek(file, 0, SEEK_END) && 0 <= (size = ftell(file)) &&
+      0 == fseek(file, 0, SEEK_SET)) {
+    strncpy(entry.name, name, sizeof(entry.name) - 1);
+    entry.size = (uint32_t)size;
+    status = (1 == fwrite(&entry, sizeof(entry), 1, snapshot)) &&
+             copy_bytes(file, snapshot, entry.size);
+  }
+  fclose(file);
+
+  if (status)
+    *count += 1;
+  return status;
+}
+
+static bool restore_file(FILE *snapshot) {
+  sim_snapshot_entry_t entry = {0};
+  FILE *file = NULL;
+  bool status = false;
+
+  if (1 != fread(&entry, sizeof(entry), 1, snapshot))
+    return false;
+  entry.name[sizeof(entry.name) - 1] = '\0';
+
+  // Only known backing files are written; a name is never used as a path
+  if (!is_snapshot_file(entry.name)) {
+    fprintf(stderr, "ERROR (snapshot): unknown file %s\n", entry.name);
+    return false;
+  }
+
+  file = open_file(entry.name, "wb");
+  if (NULL == file)
+    return false;
+  status = copy_bytes(snapshot, file, entry.size);
+  fclose(file);
+  return status;
+}
+
+static void save_at_exit(void) {
+  if (!sim_snapshot_save(save_path))
+    fprintf(stderr, "ERROR (snapshot save): %s\n", save_path);
+}
+
+bool sim_snapshot_save(const char *path) {
+  sim_snapshot_header_t header = {0};
+  FILE *snapshot = fopen(path, "wb");
+  bool status = true;
+
+  if (NULL == snapshot) {
+    perror("ERROR (snapshot save)");
+    return false;
+  }
+
+  memcpy(header.magic, SIM_SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SIM_SNAPSHOT_VERSION;
+  header.rng_seed = (uint32_t)rand();
+
+  // The header is rewritten once the number of saved files is known
+  status = (1 == fwrite(&header, sizeof(header), 1, snapshot));
+  for (size_t i = 0; status && i < SIM_SNAPSHOT_FILE_COUNT; i++) {
+    status = save_file(snapshot, snapshot_files[i], &header.file_count);
+  }
+  status = status && 0 == fseek(snapshot, 0, SEEK_SET) &&
+           1 == fwrite(&header, sizeof(header), 1, snapshot);
+
+  if (0 != fclose(snapshot))
+    status = false;
+  if (status)
+    seed_rng(header.rng_seed);
+  return status;
+}
+
+bool sim_snapshot_restore(const char *path) {
+  sim_snapshot_header_t header = {0};
+  FILE *snapshot = fopen(path, "rb");
+  bool status = false;
+
+  if (NULL == snapshot) {
+    perror("ERROR (snapshot load)");
+    return false;
+  }
+
+  if (1 != fread(&header, sizeof(header), 1, snapshot) ||
+      0 != memcmp(header.magic, SIM_SNAPSHOT_MAGIC, sizeof(header.magic)) ||
+      SIM_SNAPSHOT_VERSION != header.version ||
+      SIM_SNAPSHOT_FILE_COUNT < header.file_count) {
+    fprintf(stderr, "ERROR (snapshot load): %s is not a snapshot\n", path);
+    fclose(snapshot);
+    return false;
+  }
+
+  // Start from a blank device so that omitted files are recreated blank
+  for (size_t i = 0; i < SIM_SNAPSHOT_FILE_COUNT; i++) {
+    char file_path[SIM_INSTANCE_MAX_PATH_LEN];
+    remove(sim_instance_path(
+        NULL, snapshot_files[i], file_path, sizeof(file_path)));
+  }
+
+  status = true;
+  for (uint32_t i = 0; status && i < header.file_count; i++) {
+    status = restore_file(snapshot);
+  }
+  fclose(snapshot);
+
+  if (status)
+    seed_rng(header.rng_seed);
+  return status;
+}
+
+bool sim_snapshot_init(void) {
+  const char *load_path = getenv(SIM_SNAPSHOT_LOAD_ENV_VAR);
+
+  save_path = getenv(SIM_SNAPSHOT_SAVE_ENV_VAR);
+  if (NULL != save_path)
+    atexit(save_at_exit);
+
+  if (NULL == load_path)
+    return false;
+
+  if (!sim_snapshot_restore(load_path)) {
+    fprintf(stderr, "ERROR (snapshot load): cannot restore %s\n", load_path);
+    exit(EXIT_FAILURE);
+  }
+  return true;
+}
@@ -0,0 +1,61 @@
+#ifndef __SIM_SNAPSHOT_HEADER__
+#define __SIM_SNAPSHOT_HEADER__
+
+#include <stdbool.h>
+
+/* Device state snapshots for the simulator.
+ *
+ * CY_SIM_SNAPSHOT_LOAD=<file>  Restore the device state from <file> before
+ *                              the firmware starts, e.g. a provisioned device
+ *                              with wallets on its cards.
+ * CY_SIM_SNAPSHOT_SAVE=<file>  Save the device state into <file> when the
+ *                              simulator exits.
+ *
+ * A snapshot holds every persistent backing file of the instance (flash image,
+ * secure flash and the emulated card database) and the seed of the simulated
+ * RNG. Files are restored into the paths of the running instance, so one
+ * snapshot can seed any number of parallel instances (@see sim_instance.h).
+ *
+ * Snapshot file format (binary, host endianness):
+ *   header  "CYSIMSNP", version, RNG seed and file count (uint32 each)
+ *   file    name (32 bytes, NUL padded), size (uint32) and contents; repeated
+ *           file count times */
+#define SIM_SNAPSHOT_LOAD_ENV_VAR "CY_SIM_SNAPSHOT_LOAD"
+#define SIM_SNAPSHOT_SAVE_ENV_VAR "CY_SIM_SNAPSHOT_SAVE"
+
+/**
+ * @brief Reads the snapshot configuration from the environment, restores the
+ * requested snapshot and schedules the save at exit.
+ * @details Must run before the flash or the cards are accessed. The process
+ * exits if the snapshot cannot be restored, as continuing from a partially
+ * restored state would silently invalidate the test using it.
+ *
+ * @return true if a snapshot was restored (the RNG is then seeded from it),
+ * false otherwise
+ */
+bool sim_snapshot_init(void);
+
+/**
+ * @brief Saves the current device state of this instance into a snapshot file
+ * @details The RNG is reseeded with the seed stored in the snapshot so that
+ * this run and every restore of the snapshot continue with the same random
+ * sequence.
+ *
+ * @param path Destination of the snapshot
+ *
+ * @return true if the snapshot was written, false otherwise
+ */
+bool sim_snapshot_save(const char *path);
+
+/**
+ * @brief Replaces the device state of this instance with a snapshot file
+ * @details Backing files absent from the snapshot are deleted so that they
+ * are recreated blank, as on a fresh device.
+ *
+ * @param path Snapshot to restore
+ *
+ * @return true if the snapshot was restored, false otherwise
+ */
+bool sim_snapshot_restore(const char *path);
+
+#endif
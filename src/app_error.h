@@ -148,7 +148,9 @@ typedef enum card_status_word {
   SW_FILE_NOT_FOUND = 0x6A82,
   SW_RECORD_NOT_FOUND = 0x6A83,
   SW_FILE_FULL = 0x6A84,
+  SW_INCORRECT_P1P2 = 0x6A86,
   POW_SW_CHALLENGE_FAILED = 0x6A88,
+  SW_WRONG_P1P2 = 0x6B00,
   SW_CORRECT_LENGTH_00 = 0x6C00,
   SW_INVALID_INS = 0x6D00,
   SW_NOT_PAIRED = 0x7985,
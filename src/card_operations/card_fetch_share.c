@@ -169,12 +169,9 @@ static bool _handle_retrieve_wallet_success(uint8_t xcor) {
     return false;
   }
 
-  if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info)) {
-    memcpy(((uint8_t *)wallet_shamir_data.arbitrary_data_shares) +
-               xcor * wallet.arbitrary_data_size,
-           wallet.arbitrary_data_share,
-           wallet.arbitrary_data_size);
-  } else {
+  // Arbitrary data is never recovered on the device, so only mnemonic shares
+  // are kept
+  if (!WALLET_IS_ARBITRARY_DATA(wallet.wallet_info)) {
     memcpy(wallet_shamir_data.mnemonic_shares[xcor],
            wallet.wallet_share_with_mac_and_nonce,
            BLOCK_SIZE);
@@ -223,7 +220,8 @@ card_error_type_e card_fetch_share(const card_fetch_share_config_t *config,
     card_initialize_applet(&card_data);
 
     if (CARD_OPERATION_SUCCESS == card_data.error_type) {
-      card_data.nfc_data.status = nfc_retrieve_wallet(&wallet);
+      card_data.nfc_data.status =
+          nfc_retrieve_wallet_fields(&wallet, WALLET_FIELDS_FOR_SHARE);
 
       if (card_data.nfc_data.status == SW_NO_ERROR) {
         remaining_cards = card_data.nfc_data.acceptable_cards;
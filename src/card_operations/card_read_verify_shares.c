@@ -68,6 +68,7 @@
 #include "nfc.h"
 #include "shamir_wrapper.h"
 #include "ui_instruction.h"
+#include "utils.h"
 #include "wallet.h"
 #include "wallet_utilities.h"
 
@@ -106,15 +107,22 @@ static void read_card_share_post_process(uint8_t xcor);
  * STATIC FUNCTIONS
  *****************************************************************************/
 static void read_card_share_post_process(uint8_t xcor) {
-  if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info))
-    memcpy(((uint8_t *)wallet_shamir_data.arbitrary_data_shares) +
-               xcor * wallet.arbitrary_data_size,
-           wallet.arbitrary_data_share,
-           wallet.arbitrary_data_size);
-  else
+  if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info)) {
+    uint8_t digest[SHA256_DIGEST_LENGTH] = {0};
+
+    // The card must hold exactly the share written to it
+    sha256_Raw(wallet.arbitrary_data_share, wallet.arbitrary_data_size, digest);
+    if (0 == memcmp(digest,
+                    wallet_shamir_data.arbitrary_data_share_digests[xcor],
+                    sizeof(digest))) {
+      wallet_shamir_data.arbitrary_data_verified_cards |=
+          encode_card_number(xcor + 1);
+    }
+  } else {
     memcpy(wallet_shamir_data.mnemonic_shares[xcor],
            wallet.wallet_share_with_mac_and_nonce,
            BLOCK_SIZE);
+  }
   memcpy(wallet_shamir_data.share_encryption_data[xcor],
          wallet.wallet_share_with_mac_and_nonce + BLOCK_SIZE,
          PADDED_NONCE_SIZE + WALLET_MAC_SIZE);
@@ -183,42 +191,48 @@ bool read_card_share(uint8_t xcor, const char *heading, const char *msg) {
 }
 
 int verify_card_share_data() {
-  uint8_t CONFIDENTIAL secret[MAX_ARBITRARY_DATA_SIZE];
+  uint8_t CONFIDENTIAL secret[BLOCK_SIZE];
   uint8_t status = 0;
   uint8_t wallet_id[WALLET_ID_SIZE] = {0};
 
-  wallet_shamir_data.share_x_coords[4] = 5;
-  get_flash_wallet_share_by_name((const char *)wallet.wallet_name,
-                                 wallet_shamir_data.mnemonic_shares[4]);
-
-  if (WALLET_IS_PIN_SET(wallet.wallet_info))
-    decrypt_shares();
   if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info)) {
-    status = generate_data_5C2(wallet.arbitrary_data_size,
-                               wallet_shamir_data.arbitrary_data_shares,
-                               wallet_shamir_data.share_x_coords,
-                               secret);
-    memzero(wallet_shamir_data.arbitrary_data_shares,
-            sizeof(wallet_shamir_data.arbitrary_data_shares));
+    // The shares are derived from the data entered, so cards holding them
+    // unaltered recover the wallet
+    status = (0x0F == wallet_shamir_data.arbitrary_data_verified_cards) ? 1 : 0;
+    memzero(wallet_shamir_data.arbitrary_data_share_digests,
+            sizeof(wallet_shamir_data.arbitrary_data_share_digests));
+    wallet_shamir_data.arbitrary_data_verified_cards = 0;
   } else {
+    wallet_shamir_data.share_x_coords[4] = 5;
+    get_flash_wallet_share_by_name((const char *)wallet.wallet_name,
+                                   wallet_shamir_data.mnemonic_shares[4]);
+
+    if (WALLET_IS_PIN_SET(wallet.wallet_info))
+      decrypt_shares();
     status = generate_shares_5C2(wallet_shamir_data.mnemonic_shares,
                                  wallet_shamir_data.share_x_coords,
                                  secret);
     memzero(wallet_shamir_data.mnemonic_shares,
             sizeof(wallet_shamir_data.mnemonic_shares));
-  }
 
-  if (status == 1) {
-    // verify wallet id only if secret successfully regenerated
-    mnemonic_clear();
-    const char *mnemo =
-        mnemonic_from_data(secret, wallet.number_of_mnemonics * 4 / 3);
-    ASSERT(mnemo != NULL);
-    calculate_wallet_id(wallet_id, mnemo);
-    status = memcmp(wallet.wallet_id, wallet_id, WALLET_ID_SIZE);
-    LOG_INFO("xxx36: %d", status);
-    status = (status == 0) ? 1 : 0;
-    mnemonic_clear();
+    if (status == 1) {
+      // verify wallet id only if secret successfully regenerated
+      mnemonic_clear();
+      const char *mnemo =
+          mnemonic_from_data(secret, wallet.number_of_mnemonics * 4 / 3);
+      ASSERT(mnemo != NULL);
+      bool calculated = calculate_wallet_id(wallet_id, mnemo);
+      mnemonic_clear();
+      if (!calculated) {
+        // Abandoned by a P0 event; the wallet state is left untouched as the
+        // shares were never judged
+        memzero(secret, sizeof(secret));
+        return 0;
+      }
+      status = memcmp(wallet.wallet_id, wallet_id, WALLET_ID_SIZE);
+      LOG_INFO("xxx36: %d", status);
+      status = (status == 0) ? 1 : 0;
+    }
   }
 
   // both checks complete; accordingly update on flash
@@ -71,6 +71,7 @@
  * EXTERN VARIABLES
  *****************************************************************************/
 extern Wallet_shamir_data wallet_shamir_data;
+extern char arbitrary_data[4096 / 8 + 1];
 
 /*****************************************************************************
  * PRIVATE MACROS AND DEFINES
@@ -123,10 +124,11 @@ static uint32_t wallet_index;    // What's the index of the wallet in flash to
  *****************************************************************************/
 static void write_card_pre_process(uint8_t card_num) {
   if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info))
-    memcpy(wallet.arbitrary_data_share,
-           ((uint8_t *)wallet_shamir_data.arbitrary_data_shares) +
-               (card_num - 1) * wallet.arbitrary_data_size,
-           wallet.arbitrary_data_size);
+    shamir_stream_split(&wallet_shamir_data.arbitrary_data_stream,
+                        wallet.arbitrary_data_size,
+                        (const uint8_t *)arbitrary_data,
+                        card_num,
+                        wallet.arbitrary_data_share);
   else
     memcpy(wallet.wallet_share_with_mac_and_nonce,
            wallet_shamir_data.mnemonic_shares[card_num - 1],
@@ -166,20 +168,24 @@ static void write_card_share_post_process(uint8_t card_num) {
 
   put_wallet_flash(wallet_index, wallet_for_flash);
 
-  if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info))
-    memset(((uint8_t *)wallet_shamir_data.arbitrary_data_shares) +
-               (card_num - 1) * wallet.arbitrary_data_size,
-           0,
-           wallet.arbitrary_data_size);
-  else
+  if (WALLET_IS_ARBITRARY_DATA(wallet.wallet_info)) {
+    // Only the digest is kept for the read back; the share is cleared
+    sha256_Raw(wallet.arbitrary_data_share,
+               wallet.arbitrary_data_size,
+               wallet_shamir_data.arbitrary_data_share_digests[card_num - 1]);
+    memzero(wallet.arbitrary_data_share, sizeof(wallet.arbitrary_data_share));
+    if ((TOTAL_NUMBER_OF_SHARES - 1) == card_num) {
+      // Every card holds its share now, the data is no longer needed
+      memzero(arbitrary_data, sizeof(arbitrary_data));
+      memzero(&wallet_shamir_data.arbitrary_data_stream,
+              sizeof(wallet_shamir_data.arbitrary_data_stream));
+    }
+  } else {
     memset(wallet_shamir_data.mnemonic_shares[card_num - 1], 0, BLOCK_SIZE);
+  }
   memset(wallet_shamir_data.share_encryption_data[card_num - 1],
          0,
          sizeof(wallet_shamir_data.share_encryption_data[card_num - 1]));
-  memset(((uint8_t *)wallet_shamir_data.arbitrary_data_shares) +
-             (card_num - 1) * wallet.arbitrary_data_size,
-         0,
-         wallet.arbitrary_data_size);
   return;
 }
 
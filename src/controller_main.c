@@ -115,15 +115,6 @@
  */
 lv_task_t *timeout_task;
 
-/**
- * @brief A task declared to execute a callback after timeout when displaying
- * scrolling address.
- *
- * This timeout task in used in ui_address for showing the hidden buttons after
- * timeout when user verifies the scrolling receipt address.
- */
-lv_task_t *address_timeout_task = NULL;
-
 /// Used to determine the state of authentication
 uint8_t device_auth_flag = 0;
 
@@ -213,6 +204,9 @@ void reset_flow_level() {
   memzero(wallet.password_double_hash, sizeof(wallet.password_double_hash));
   memzero(wallet_credential_data.passphrase,
           sizeof(wallet_credential_data.passphrase));
+  memzero(arbitrary_data, sizeof(arbitrary_data));
+  memzero(&wallet_shamir_data.arbitrary_data_stream,
+          sizeof(wallet_shamir_data.arbitrary_data_stream));
   cy_free();
   pb_release(MessageData_fields, &msg_data);
   current_display_node = NULL;
@@ -385,9 +379,6 @@ void desktop_listener_task(lv_task_t *data) {
 }
 
 void cy_exit_flow() {
-  if (address_timeout_task != NULL)
-    address_timeout_task->task_cb(NULL);
-
   lv_obj_clean(lv_scr_act());
   sys_flow_cntrl_u.bits.reset_flow = false;
   reset_flow_level();
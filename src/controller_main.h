@@ -247,7 +247,6 @@ typedef struct Counter {
 extern Flow_level flow_level;
 extern Counter counter;
 extern Wallet wallet;
-extern lv_task_t *address_timeout_task;
 extern uint32_t inactivity_counter;
 
 /**
@@ -364,6 +364,27 @@ provision_status_t check_provision_status();
  */
 uint32_t get_device_serial();
 
+/**
+ * @brief Fetch the ATECC config zone
+ * @details The config zone of a fully provisioned device is read once per boot
+ * and served from an integrity checked copy in RAM afterwards.
+ *
+ * @param [out] config  - buffer of ATCA_ECC_CONFIG_SIZE bytes
+ *
+ * @return    ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atecc_get_config_zone(uint8_t *config);
+
+/**
+ * @brief Fetch the 9 byte ATECC serial number. Same as
+ * atcab_read_serial_number() but served from the cached config zone.
+ *
+ * @param [out] serial_number  - buffer of ATCA_SERIAL_NUM_SIZE bytes
+ *
+ * @return    ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atecc_get_serial_number(uint8_t *serial_number);
+
 /**
  * @brief Request ATECC to generate signature on the hash with private available
  * on SLOT-3
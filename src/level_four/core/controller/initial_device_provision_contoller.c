@@ -64,6 +64,7 @@
 #include "curves.h"
 #include "flash_api.h"
 #include "nist256p1.h"
+#include "stddef.h"
 #include "string.h"
 #include "ui_delay.h"
 #include "ui_instruction.h"
@@ -104,52 +105,54 @@ static void __timeout_listener();
 static void lock_all_slots();
 #endif
 
-uint32_t get_device_serial() {
-  atecc_data.retries = DEFAULT_ATECC_RETRIES;
+/**
+ * The config zone and the device serial do not change once the device is
+ * provisioned, so they are read from the ATECC only once per boot. The CRC
+ * guards the copy in RAM; a mismatch makes the next access read them again.
+ */
+typedef struct {
+  uint8_t config[ATCA_ECC_CONFIG_SIZE];
+  uint8_t device_serial[DEVICE_SERIAL_SIZE];
+  uint8_t crc[ATCA_CRC_SIZE];
+  bool valid;
+} atecc_cache_t;
+
+static atecc_cache_t atecc_cache;
+
+static ATCA_STATUS read_config_zone(uint8_t *config) {
+  ATCA_STATUS status = ATCA_FUNC_FAIL;
+  uint8_t retries = DEFAULT_ATECC_RETRIES;
   bool usb_irq_enable_on_entry = NVIC_GetEnableIRQ(OTG_FS_IRQn);
 
   NVIC_DisableIRQ(OTG_FS_IRQn);
   do {
-    atecc_data.status = atcab_init(atecc_data.cfg_atecc608a_iface);
-    atecc_data.status = atcab_read_zone(ATCA_ZONE_DATA,
-                                        slot_8_serial,
-                                        0,
-                                        0,
-                                        atecc_data.device_serial,
-                                        DEVICE_SERIAL_SIZE);
-  } while (atecc_data.status != ATCA_SUCCESS && --atecc_data.retries);
+    status = atcab_init(atecc_data.cfg_atecc608a_iface);
+    status = atcab_read_config_zone(config);
+  } while (status != ATCA_SUCCESS && --retries);
   if (usb_irq_enable_on_entry == true)
     NVIC_EnableIRQ(OTG_FS_IRQn);
 
-  if (atecc_data.status == ATCA_SUCCESS) {
-    if (0 != memcmp(atecc_data.device_serial + 8, (void *)UID_BASE, 12)) {
-      return 1;
-    } else {
-      return SUCCESS;
-    }
-  }
-  return atecc_data.status;
+  return status;
 }
 
-provision_status_t check_provision_status() {
-  uint8_t cfg[128];
-  memset(cfg, 0, 128);
-  atecc_data.retries = DEFAULT_ATECC_RETRIES;
-
+static ATCA_STATUS read_device_serial(uint8_t *serial) {
+  ATCA_STATUS status = ATCA_FUNC_FAIL;
+  uint8_t retries = DEFAULT_ATECC_RETRIES;
   bool usb_irq_enable_on_entry = NVIC_GetEnableIRQ(OTG_FS_IRQn);
+
   NVIC_DisableIRQ(OTG_FS_IRQn);
   do {
-    atecc_data.status = atcab_init(atecc_data.cfg_atecc608a_iface);
-    atecc_data.status = atcab_read_config_zone(cfg);
-  } while (atecc_data.status != ATCA_SUCCESS && --atecc_data.retries);
+    status = atcab_init(atecc_data.cfg_atecc608a_iface);
+    status = atcab_read_zone(
+        ATCA_ZONE_DATA, slot_8_serial, 0, 0, serial, DEVICE_SERIAL_SIZE);
+  } while (status != ATCA_SUCCESS && --retries);
   if (usb_irq_enable_on_entry == true)
     NVIC_EnableIRQ(OTG_FS_IRQn);
 
-  if (atecc_data.status != ATCA_SUCCESS) {
-    LOG_CRITICAL("xxx30: %d", atecc_data.status);
-    return -1;
-  }
+  return status;
+}
 
+static provision_status_t provision_status_from_config(const uint8_t *cfg) {
   if (cfg[86] == 0x00 &&
       cfg[87] == 0x00) {    // config zone and data zones are locked
 
@@ -174,6 +177,112 @@ provision_status_t check_provision_status() {
   }
 }
 
+static bool atecc_cache_is_intact(void) {
+  uint8_t crc[ATCA_CRC_SIZE] = {0};
+
+  if (atecc_cache.valid == false) {
+    return false;
+  }
+
+  atCRC(offsetof(atecc_cache_t, crc), (const uint8_t *)&atecc_cache, crc);
+  if (0 != memcmp(crc, atecc_cache.crc, sizeof(crc))) {
+    LOG_CRITICAL("xxx31");
+    memset(&atecc_cache, 0, sizeof(atecc_cache));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Caches the config zone if it describes a fully provisioned device, i.e. the
+ * zones and all the key slots are locked and nothing can change anymore.
+ */
+static void atecc_cache_fill(const uint8_t *config) {
+  if (provision_status_from_config(config) != provision_complete) {
+    return;
+  }
+
+  memset(&atecc_cache, 0, sizeof(atecc_cache));
+  if (read_device_serial(atecc_cache.device_serial) != ATCA_SUCCESS) {
+    return;
+  }
+  memcpy(atecc_cache.config, config, sizeof(atecc_cache.config));
+  atCRC(offsetof(atecc_cache_t, crc),
+        (const uint8_t *)&atecc_cache,
+        atecc_cache.crc);
+  atecc_cache.valid = true;
+}
+
+static bool atecc_cache_load(void) {
+  uint8_t cfg[ATCA_ECC_CONFIG_SIZE] = {0};
+
+  if (atecc_cache_is_intact()) {
+    return true;
+  }
+
+  if (read_config_zone(cfg) == ATCA_SUCCESS) {
+    atecc_cache_fill(cfg);
+  }
+  return atecc_cache_is_intact();
+}
+
+uint32_t get_device_serial() {
+  if (atecc_cache_load()) {
+    memcpy(atecc_data.device_serial,
+           atecc_cache.device_serial,
+           DEVICE_SERIAL_SIZE);
+    atecc_data.status = ATCA_SUCCESS;
+  } else {
+    atecc_data.status = read_device_serial(atecc_data.device_serial);
+  }
+
+  if (atecc_data.status == ATCA_SUCCESS) {
+    if (0 != memcmp(atecc_data.device_serial + 8, (void *)UID_BASE, 12)) {
+      return 1;
+    } else {
+      return SUCCESS;
+    }
+  }
+  return atecc_data.status;
+}
+
+ATCA_STATUS atecc_get_config_zone(uint8_t *config) {
+  if (atecc_cache_load()) {
+    memcpy(config, atecc_cache.config, ATCA_ECC_CONFIG_SIZE);
+    return ATCA_SUCCESS;
+  }
+  return read_config_zone(config);
+}
+
+ATCA_STATUS atecc_get_serial_number(uint8_t *serial_number) {
+  uint8_t cfg[ATCA_ECC_CONFIG_SIZE] = {0};
+  ATCA_STATUS status = atecc_get_config_zone(cfg);
+
+  if (status == ATCA_SUCCESS) {
+    // same layout as atcab_read_serial_number()
+    memcpy(&serial_number[0], &cfg[0], 4);
+    memcpy(&serial_number[4], &cfg[8], 5);
+  }
+  return status;
+}
+
+provision_status_t check_provision_status() {
+  uint8_t cfg[ATCA_ECC_CONFIG_SIZE] = {0};
+
+  if (atecc_cache_is_intact()) {
+    return provision_status_from_config(atecc_cache.config);
+  }
+
+  atecc_data.status = read_config_zone(cfg);
+  if (atecc_data.status != ATCA_SUCCESS) {
+    LOG_CRITICAL("xxx30: %d", atecc_data.status);
+    return -1;
+  }
+
+  atecc_cache_fill(cfg);
+  return provision_status_from_config(cfg);
+}
+
 void device_provision_controller() {
 #if X1WALLET_INITIAL
   switch (flow_level.level_three) {
@@ -63,6 +63,7 @@
 #include "controller_level_four.h"
 #include "controller_tap_cards.h"
 #include "harmony.h"
+#include "progress_api.h"
 #include "sha2.h"
 #include "shamir_wrapper.h"
 #include "ui_confirmation.h"
@@ -163,10 +164,20 @@ void receive_transaction_controller_eth() {
       uint8_t seed[64];
 
       memzero(seed, sizeof(seed));
-      mnemonic_to_seed(mnemo, wallet_credential_data.passphrase, seed, NULL);
+      // The derivation is abandoned on a host abort or inactivity
+      bool derived =
+          (1 == mnemonic_to_seed_yield(mnemo,
+                                       wallet_credential_data.passphrase,
+                                       seed,
+                                       progress_api_yield));
       mnemonic_clear();
       memzero(wallet_credential_data.passphrase,
               sizeof(wallet_credential_data.passphrase));
+      if (!derived) {
+        memzero(secret, sizeof(secret));
+        reset_flow_level();
+        break;
+      }
       hdnode_from_seed(seed, sizeof(seed), SECP256K1_NAME, &node);
 
       hdnode_private_ckd(
@@ -63,6 +63,7 @@
 #include "controller_level_four.h"
 #include "controller_tap_cards.h"
 #include "near_context.h"
+#include "progress_api.h"
 #include "sha2.h"
 #include "shamir_wrapper.h"
 #include "ui_confirmation.h"
@@ -200,10 +201,20 @@ void receive_transaction_controller_near() {
 
       memzero(seed, sizeof(seed));
 
-      mnemonic_to_seed(mnemo, wallet_credential_data.passphrase, seed, NULL);
+      // The derivation is abandoned on a host abort or inactivity
+      bool derived =
+          (1 == mnemonic_to_seed_yield(mnemo,
+                                       wallet_credential_data.passphrase,
+                                       seed,
+                                       progress_api_yield));
       mnemonic_clear();
       memzero(wallet_credential_data.passphrase,
               sizeof(wallet_credential_data.passphrase));
+      if (!derived) {
+        memzero(secret, sizeof(secret));
+        reset_flow_level();
+        break;
+      }
 
       uint32_t path[] = {
           BYTE_ARRAY_TO_UINT32(receive_transaction_data.purpose),
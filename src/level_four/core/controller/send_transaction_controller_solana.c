@@ -249,14 +249,16 @@ void send_transaction_controller_solana() {
       ASSERT(mnemo != NULL);
 
       uint8_t sig[64];
-      solana_sig_unsigned_byte_array(
+      bool signed_txn = solana_sig_unsigned_byte_array(
           solana_unsigned_txn_byte_array,
           solana_unsigned_txn_len,
           (const txn_metadata *)&var_send_transaction_data.transaction_metadata,
           mnemo,
           wallet_credential_data.passphrase,
           sig);
-      transmit_data_to_app(SEND_TXN_SENDING_SIGNED_TXN, sig, 64);
+      if (signed_txn) {
+        transmit_data_to_app(SEND_TXN_SENDING_SIGNED_TXN, sig, 64);
+      }
       mnemonic_clear();
       memzero(secret, sizeof(secret));
       memzero(wallet_shamir_data.mnemonic_shares,
@@ -264,6 +266,11 @@ void send_transaction_controller_solana() {
       memzero(wallet_credential_data.passphrase,
               sizeof(wallet_credential_data.passphrase));
 
+      if (!signed_txn) {
+        // The host aborted or the device timed out while deriving the seed
+        reset_flow_level();
+        break;
+      }
       flow_level.level_three = SEND_TXN_WAITING_SCREEN_SOLANA;
     } break;
 
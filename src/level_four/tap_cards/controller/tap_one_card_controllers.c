@@ -86,7 +86,7 @@ void controller_update_card_id() {
           flow_level.screen_input.input_text, 2 * CARD_ID_SIZE, send_apdu + 5);
 
       uint8_t recv_apdu[255];
-      uint16_t recv_len = 236;
+      uint16_t recv_len = sizeof(recv_apdu);
       while (1) {
         // todo log
         nfc_select_card();    // Stuck here until card is detected
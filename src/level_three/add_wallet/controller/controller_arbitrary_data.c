@@ -198,12 +198,10 @@ void arbitrary_data_controller() {
         WALLET_SET_ARBITRARY_DATA(wallet.wallet_info);
         WALLET_SET_ARBITRARY_DATA(wallet_for_flash.wallet_info);
 
-        convert_to_shares(wallet.arbitrary_data_size,
-                          (uint8_t *)arbitrary_data,
-                          wallet.total_number_of_shares,
-                          wallet.minimum_number_of_shares,
-                          wallet_shamir_data.arbitrary_data_shares);
-        memzero(arbitrary_data, sizeof(arbitrary_data));
+        // Shares are produced block by block as each card is written, the
+        // data is cleared once the last card is written
+        shamir_stream_init(&wallet_shamir_data.arbitrary_data_stream,
+                           wallet.minimum_number_of_shares);
         flow_level.level_three = ARBITRARY_DATA_TAP_CARDS;
         flow_level.level_four = 1;
         flow_level.level_five = 1;
@@ -223,6 +221,9 @@ void arbitrary_data_controller() {
       flow_level.level_three = verify_card_share_data() == 1
                                    ? ARBITRARY_DATA_SUCCESS_MESSAGE
                                    : ARBITRARY_DATA_FAILED_MESSAGE;
+      memzero(arbitrary_data, sizeof(arbitrary_data));
+      memzero(&wallet_shamir_data.arbitrary_data_stream,
+              sizeof(wallet_shamir_data.arbitrary_data_stream));
       memzero(wallet.password_double_hash, sizeof(wallet.password_double_hash));
       memzero(wallet.wallet_share_with_mac_and_nonce,
               sizeof(wallet.wallet_share_with_mac_and_nonce));
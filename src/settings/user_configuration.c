@@ -65,6 +65,7 @@
 #include "constant_texts.h"
 #include "flash_api.h"
 #include "flash_struct.h"
+#include "logger.h"
 #include "settings_api.h"
 #include "ui_core_confirm.h"
 #include "ui_screens.h"
@@ -111,6 +112,7 @@ void toggle_log_export(void) {
   if (core_confirmation(msg, NULL)) {
     set_logging_config(logging_enabled ? LOGGING_DISABLED : LOGGING_ENABLED,
                        FLASH_SAVE_NOW);
+    logger_apply_config();
   }
 
   return;
@@ -325,7 +325,14 @@ new_wallet_state_e new_wallet_state_handler(new_wallet_state_e current_state) {
 
       ASSERT(mnemo != NULL);
 
-      calculate_wallet_id(wallet_for_flash.wallet_id, mnemo);
+      // The derivations yield to the host; a P0 event abandons the creation
+      if (!calculate_wallet_id(wallet_for_flash.wallet_id, mnemo)) {
+        mnemonic_clear();
+        memzero(wallet.wallet_share_with_mac_and_nonce,
+                sizeof(wallet.wallet_share_with_mac_and_nonce));
+        next_state = TIMED_OUT;
+        break;
+      }
       memcpy(wallet.wallet_id, wallet_for_flash.wallet_id, WALLET_ID_SIZE);
       convert_to_shares(32,
                         wallet.wallet_share_with_mac_and_nonce /*secret*/,
@@ -338,13 +345,18 @@ new_wallet_state_e new_wallet_state_handler(new_wallet_state_e current_state) {
       if (WALLET_IS_PIN_SET(wallet.wallet_info)) {
         encrypt_shares();
       }
-      derive_beneficiary_key(
-          wallet.beneficiary_key, wallet.iv_for_beneficiary_key, mnemo);
-      derive_wallet_key(wallet.key, mnemo);
+      bool derived = derive_beneficiary_key(wallet.beneficiary_key,
+                                            wallet.iv_for_beneficiary_key,
+                                            mnemo) &&
+                     derive_wallet_key(wallet.key, mnemo);
       mnemonic_clear();
       memzero(wallet.wallet_share_with_mac_and_nonce,
               sizeof(wallet.wallet_share_with_mac_and_nonce));
 
+      if (!derived) {
+        next_state = TIMED_OUT;
+        break;
+      }
       next_state = SAVE_WALLET_SHARE_TO_DEVICE;
       break;
     }
@@ -65,6 +65,7 @@
 #include "common_error.h"
 #include "constant_texts.h"
 #include "core_error.h"
+#include "progress_api.h"
 #include "sha2.h"
 #include "shamir_wrapper.h"
 #include "status_api.h"
@@ -157,6 +158,11 @@ static const char *reconstruct_wallet(const uint8_t *wallet_id,
  * @param wallet_id A pointer to an array uint8_t with wallet id, wallet_id  is
  * compared against the wallet id generated from mnemonics, if same wallet id is
  * generated, then wallet is verified.
+ * @details The check value of the entropy stored with the wallet is compared
+ * first. The wallet id is derived from the mnemonics only if the wallet is not
+ * enrolled yet or the check value does not match, and the check value is
+ * (re)enrolled once the wallet id is verified. A single PBKDF2 run is then left
+ * to generate the seed of the flow.
  *
  * @return a pointer to a constant character mnemonics string (const char *).
  */
@@ -325,9 +331,41 @@ static const char *generate_mnemonics_and_verify_wallet(
       mnemonic_from_data(secret, wallet.number_of_mnemonics * 4 / 3);
   ASSERT(mnemonics != NULL);
 
-  if (!verify_wallet_id(wallet_id, mnemonics)) {
-    mark_core_error_screen(ui_text_wallet_verification_failed_in_reconstruction,
-                           false);
+  uint8_t seed_tag[WALLET_SEED_TAG_SIZE] = {0};
+  uint8_t wallet_index = 0;
+  const uint8_t *stored_tag = NULL;
+  bool verified = false;
+  const bool in_flash =
+      (SUCCESS_ == get_first_matching_index_by_id(wallet_id, &wallet_index));
+
+  calculate_seed_tag(
+      wallet_id, secret, wallet.number_of_mnemonics * 4 / 3, seed_tag);
+  if (in_flash) {
+    stored_tag = get_wallet_seed_tag(wallet_index);
+  }
+
+  if (NULL != stored_tag &&
+      0 == memcmp(stored_tag, seed_tag, WALLET_SEED_TAG_SIZE)) {
+    verified = true;
+  } else {
+    progress_api_start(ui_text_processing);
+    verified = verify_wallet_id(wallet_id, mnemonics);
+    progress_api_stop();
+
+    if (verified && in_flash) {
+      // Enroll the wallet so that later reconstructions skip the derivation
+      set_wallet_seed_tag(wallet_index, seed_tag);
+    }
+  }
+  memzero(seed_tag, sizeof(seed_tag));
+
+  if (!verified) {
+    // An abandoned derivation is not a verification failure; the pending P0
+    // event is handled by the caller flow
+    if (!progress_api_is_aborted()) {
+      mark_core_error_screen(
+          ui_text_wallet_verification_failed_in_reconstruction, false);
+    }
     mnemonics = NULL;
   }
   return mnemonics;
@@ -359,7 +397,7 @@ static const char *reconstruct_wallet(const uint8_t *wallet_id,
   if (COMPLETED == current_state) {
     mnemonics = generate_mnemonics_and_verify_wallet(secret, wallet_id);
     if (NULL == mnemonics) {
-      if (reject_cb) {
+      if (reject_cb && !progress_api_is_aborted()) {
         reject_cb(ERROR_COMMON_ERROR_CARD_ERROR_TAG,
                   ERROR_CARD_ERROR_SW_RECORD_NOT_FOUND);
       }
@@ -394,9 +432,12 @@ bool reconstruct_seed(const uint8_t *wallet_id,
       reconstruct_wallet(wallet_id, PASSPHRASE_INPUT, reject_cb);
 
   if (NULL != mnemonics) {
-    mnemonic_to_seed(
-        mnemonics, wallet_credential_data.passphrase, seed_out, NULL);
-    result = true;
+    progress_api_start(ui_text_processing);
+    result = (1 == mnemonic_to_seed_yield(mnemonics,
+                                          wallet_credential_data.passphrase,
+                                          seed_out,
+                                          progress_api_yield));
+    progress_api_stop();
   }
 
   mnemonic_clear();
@@ -410,8 +410,13 @@ restore_wallet_state_e restore_wallet_state_handler(
         break;
       }
 
-      // Check if the seed phrase matches an already existing wallet
-      calculate_wallet_id(temp_wallet_id, single_line_mnemonics);
+      // Check if the seed phrase matches an already existing wallet. The
+      // derivation yields to the host; a P0 event abandons the restore
+      if (!calculate_wallet_id(temp_wallet_id, single_line_mnemonics)) {
+        memzero(single_line_mnemonics, sizeof(single_line_mnemonics));
+        next_state = TIMED_OUT;
+        break;
+      }
       if (get_first_matching_index_by_id(temp_wallet_id, &wallet_index) ==
           SUCCESS_) {
         mark_core_error_screen(ui_text_wallet_with_same_mnemo_exists, false);
@@ -439,12 +444,16 @@ restore_wallet_state_e restore_wallet_state_handler(
       if (WALLET_IS_PIN_SET(wallet.wallet_info)) {
         encrypt_shares();
       }
-      derive_beneficiary_key(wallet.beneficiary_key,
-                             wallet.iv_for_beneficiary_key,
-                             single_line_mnemonics);
-      derive_wallet_key(wallet.key, single_line_mnemonics);
+      bool derived = derive_beneficiary_key(wallet.beneficiary_key,
+                                            wallet.iv_for_beneficiary_key,
+                                            single_line_mnemonics) &&
+                     derive_wallet_key(wallet.key, single_line_mnemonics);
       memzero(single_line_mnemonics, sizeof(single_line_mnemonics));
 
+      if (!derived) {
+        next_state = TIMED_OUT;
+        break;
+      }
       next_state = VERIFY_SEED;
       break;
     }
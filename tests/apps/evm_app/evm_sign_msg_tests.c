@@ -191,6 +191,11 @@ TEST(evm_sign_msg_test, evm_sign_msg_test_personal_sign_hash) {
                  "3383938333735353631";
   ctx.msg_data = buffer;
   hex_string_to_byte_array(string, ctx.init.total_msg_size * 2, buffer);
+
+  // Feed the message in two chunks as received over USB
+  evm_init_msg_data_digest(&ctx);
+  evm_update_msg_data_digest(&ctx, buffer, 16);
+  evm_update_msg_data_digest(&ctx, buffer + 16, ctx.init.total_msg_size - 16);
   TEST_ASSERT_TRUE(evm_get_msg_data_digest(&ctx, digest));
   TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_digest, digest, SHA256_DIGEST_LENGTH);
 }
@@ -224,6 +229,11 @@ TEST(evm_sign_msg_test, evm_sign_msg_test_eth_sign_hash) {
                  "3383938343031363333";
   ctx.msg_data = buffer;
   hex_string_to_byte_array(string, ctx.init.total_msg_size * 2, buffer);
+
+  // Feed the message in two chunks as received over USB
+  evm_init_msg_data_digest(&ctx);
+  evm_update_msg_data_digest(&ctx, buffer, 16);
+  evm_update_msg_data_digest(&ctx, buffer + 16, ctx.init.total_msg_size - 16);
   TEST_ASSERT_TRUE(evm_get_msg_data_digest(&ctx, digest));
   TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_digest, digest, SHA256_DIGEST_LENGTH);
 }
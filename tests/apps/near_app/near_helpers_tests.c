@@ -241,4 +241,15 @@ TEST(near_helper_test, near_helper_sign_txn) {
       expected_signature);
   TEST_ASSERT_EQUAL_UINT8_ARRAY(
       expected_signature, signature, sizeof(expected_signature));
+
+  // Signing with the pre-expanded key must yield the same key and signature
+  ed25519_expanded_key key = {0};
+  ed25519_expand_key(secret_key, &key);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(
+      expected_public_key, key.pk, sizeof(expected_public_key));
+
+  memzero(signature, sizeof(signature));
+  ed25519_sign_expanded(digest, sizeof(digest), &key, signature);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(
+      expected_signature, signature, sizeof(expected_signature));
 }
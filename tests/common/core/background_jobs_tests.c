@@ -0,0 +1,159 @@
+/**
+ * @file    background_jobs_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the background job scheduler
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "background_jobs.h"
+#include "unity_fixture.h"
+
+typedef struct {
+  uint32_t steps;
+  uint32_t total;
+  uint32_t *trace;
+  uint32_t *trace_len;
+  uint32_t id;
+} test_job_arg_t;
+
+static background_job_t job_a;
+static background_job_t job_b;
+static test_job_arg_t arg_a;
+static test_job_arg_t arg_b;
+static uint32_t trace[16];
+static uint32_t trace_len;
+
+static bool test_job_step(void *arg) {
+  test_job_arg_t *job_arg = (test_job_arg_t *)arg;
+  job_arg->trace[(*job_arg->trace_len)++] = job_arg->id;
+  job_arg->steps++;
+  return job_arg->steps >= job_arg->total;
+}
+
+static void init_arg(test_job_arg_t *arg, uint32_t id, uint32_t total) {
+  memset(arg, 0, sizeof(*arg));
+  arg->id = id;
+  arg->total = total;
+  arg->trace = trace;
+  arg->trace_len = &trace_len;
+}
+
+TEST_GROUP(background_jobs_tests);
+
+TEST_SETUP(background_jobs_tests) {
+  memset(&job_a, 0, sizeof(job_a));
+  memset(&job_b, 0, sizeof(job_b));
+  memset(trace, 0, sizeof(trace));
+  trace_len = 0;
+  init_arg(&arg_a, 1, 3);
+  init_arg(&arg_b, 2, 2);
+}
+
+TEST_TEAR_DOWN(background_jobs_tests) {
+  background_job_cancel(&job_a);
+  background_job_cancel(&job_b);
+}
+
+TEST(background_jobs_tests, round_robin) {
+  const uint32_t expected[] = {1, 2, 1, 2, 1};
+
+  background_job_submit(&job_a, test_job_step, &arg_a);
+  background_job_submit(&job_b, test_job_step, &arg_b);
+  TEST_ASSERT_TRUE(background_jobs_pending());
+
+  // a zero budget runs a single step per call
+  while (background_jobs_run(0)) {
+  }
+
+  TEST_ASSERT_FALSE(background_jobs_pending());
+  TEST_ASSERT_EQUAL_UINT32(sizeof(expected) / sizeof(expected[0]), trace_len);
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, trace, trace_len);
+  TEST_ASSERT_TRUE(job_a.done);
+  TEST_ASSERT_TRUE(job_b.done);
+}
+
+TEST(background_jobs_tests, finish_in_foreground) {
+  background_job_submit(&job_a, test_job_step, &arg_a);
+  TEST_ASSERT_TRUE(background_jobs_run(0));
+  TEST_ASSERT_EQUAL_UINT32(1, arg_a.steps);
+
+  TEST_ASSERT_TRUE(background_job_finish(&job_a));
+  TEST_ASSERT_EQUAL_UINT32(3, arg_a.steps);
+  TEST_ASSERT_FALSE(background_jobs_pending());
+
+  // a completed job is not stepped again
+  TEST_ASSERT_TRUE(background_job_finish(&job_a));
+  TEST_ASSERT_EQUAL_UINT32(3, arg_a.steps);
+}
+
+TEST(background_jobs_tests, cancel) {
+  background_job_submit(&job_a, test_job_step, &arg_a);
+  background_job_submit(&job_b, test_job_step, &arg_b);
+  background_job_cancel(&job_a);
+
+  while (background_jobs_run(0)) {
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, arg_a.steps);
+  TEST_ASSERT_EQUAL_UINT32(2, arg_b.steps);
+  TEST_ASSERT_FALSE(background_job_finish(&job_a));
+  TEST_ASSERT_FALSE(background_jobs_run(0));
+}
+
+TEST(background_jobs_tests, finish_without_submit) {
+  TEST_ASSERT_FALSE(background_job_finish(&job_a));
+  TEST_ASSERT_FALSE(background_jobs_pending());
+}
@@ -0,0 +1,204 @@
+/**
+ * @file    ecdsa_table_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Tests for ECDSA verification with a public key table
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "ecdsa.h"
+#include "nist256p1.h"
+#include "sha2.h"
+#include "unity_fixture.h"
+#include "utils.h"
+
+#define TABLE_TEST_DIGESTS 8
+
+static const char *priv_key_hex =
+    "c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721";
+static const char *other_priv_key_hex =
+    "0000000000000000000000000000000000000000000000000000000000000001";
+
+static uint8_t priv_key[32];
+static uint8_t pub_key[65];
+static ecdsa_pubkey_table table;
+
+int pubkey_table_multiply(const ecdsa_curve *curve,
+                          const ecdsa_pubkey_table *table,
+                          const bignum256 *k,
+                          curve_point *res);
+
+static void sign_test_digest(uint8_t index,
+                             uint8_t digest[SHA256_DIGEST_LENGTH],
+                             uint8_t sig[64]) {
+  sha256_Raw(&index, sizeof(index), digest);
+  TEST_ASSERT_EQUAL(
+      0, ecdsa_sign_digest(&nist256p1, priv_key, digest, sig, NULL, NULL));
+}
+
+TEST_GROUP(ecdsa_table_tests);
+
+TEST_SETUP(ecdsa_table_tests) {
+  hex_string_to_byte_array(priv_key_hex, 64, priv_key);
+  ecdsa_get_public_key65(&nist256p1, priv_key, pub_key);
+  TEST_ASSERT_EQUAL(0, ecdsa_pubkey_table_init(&nist256p1, pub_key, &table));
+}
+
+TEST_TEAR_DOWN(ecdsa_table_tests) {
+  return;
+}
+
+TEST(ecdsa_table_tests, multiply_matches_point_multiply) {
+  curve_point pub = {0}, expected = {0}, res = {0};
+  uint8_t scalar[32] = {0};
+  bignum256 k = {0};
+
+  ecdsa_read_pubkey(&nist256p1, pub_key, &pub);
+
+  // Small scalars, equal nibbles, and the largest scalar below the order
+  const char *fixed[] = {
+      "0000000000000000000000000000000000000000000000000000000000000001",
+      "0000000000000000000000000000000000000000000000000000000000000002",
+      "000000000000000000000000000000000000000000000000000000000000000f",
+      "0000000000000000000000000000000000000000000000000000000000000010",
+      "1111111111111111111111111111111111111111111111111111111111111111",
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632550",
+  };
+  for (size_t i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++) {
+    hex_string_to_byte_array(fixed[i], 64, scalar);
+    bn_read_be(scalar, &k);
+    point_multiply(&nist256p1, &k, &pub, &expected);
+    TEST_ASSERT_EQUAL(0, pubkey_table_multiply(&nist256p1, &table, &k, &res));
+    TEST_ASSERT_TRUE(point_is_equal(&expected, &res));
+  }
+
+  for (uint8_t i = 0; i < TABLE_TEST_DIGESTS; i++) {
+    sha256_Raw(&i, sizeof(i), scalar);
+    bn_read_be(scalar, &k);
+    bn_mod(&k, &nist256p1.order);
+    point_multiply(&nist256p1, &k, &pub, &expected);
+    TEST_ASSERT_EQUAL(0, pubkey_table_multiply(&nist256p1, &table, &k, &res));
+    TEST_ASSERT_TRUE(point_is_equal(&expected, &res));
+  }
+
+  bn_zero(&k);
+  TEST_ASSERT_EQUAL(0, pubkey_table_multiply(&nist256p1, &table, &k, &res));
+  TEST_ASSERT_TRUE(point_is_infinity(&res));
+}
+
+TEST(ecdsa_table_tests, verify_accepts_valid_signatures) {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  uint8_t sig[64];
+
+  for (uint8_t i = 0; i < TABLE_TEST_DIGESTS; i++) {
+    sign_test_digest(i, digest, sig);
+    TEST_ASSERT_EQUAL(0, ecdsa_verify_digest(&nist256p1, pub_key, sig, digest));
+    TEST_ASSERT_EQUAL(
+        0, ecdsa_verify_digest_table(&nist256p1, &table, sig, digest));
+  }
+}
+
+TEST(ecdsa_table_tests, verify_rejects_wrong_key) {
+  uint8_t other_priv_key[32];
+  uint8_t other_pub_key[65];
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  uint8_t sig[64];
+  ecdsa_pubkey_table other_table;
+
+  hex_string_to_byte_array(other_priv_key_hex, 64, other_priv_key);
+  ecdsa_get_public_key65(&nist256p1, other_priv_key, other_pub_key);
+  TEST_ASSERT_EQUAL(
+      0, ecdsa_pubkey_table_init(&nist256p1, other_pub_key, &other_table));
+
+  for (uint8_t i = 0; i < TABLE_TEST_DIGESTS; i++) {
+    sign_test_digest(i, digest, sig);
+    int expected = ecdsa_verify_digest(&nist256p1, other_pub_key, sig, digest);
+    TEST_ASSERT_NOT_EQUAL(0, expected);
+    TEST_ASSERT_EQUAL(
+        expected,
+        ecdsa_verify_digest_table(&nist256p1, &other_table, sig, digest));
+  }
+}
+
+TEST(ecdsa_table_tests, verify_rejects_tampered_signature) {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  uint8_t sig[64];
+
+  for (uint8_t i = 0; i < TABLE_TEST_DIGESTS; i++) {
+    sign_test_digest(i, digest, sig);
+    // Tamper with s
+    sig[63] ^= 0x01;
+    int expected = ecdsa_verify_digest(&nist256p1, pub_key, sig, digest);
+    TEST_ASSERT_NOT_EQUAL(0, expected);
+    TEST_ASSERT_EQUAL(
+        expected, ecdsa_verify_digest_table(&nist256p1, &table, sig, digest));
+
+    // s = 0 is rejected before any multiplication
+    memset(sig + 32, 0, 32);
+    TEST_ASSERT_EQUAL(
+        ecdsa_verify_digest(&nist256p1, pub_key, sig, digest),
+        ecdsa_verify_digest_table(&nist256p1, &table, sig, digest));
+  }
+}
+
+TEST(ecdsa_table_tests, init_rejects_invalid_key) {
+  uint8_t invalid_key[65];
+
+  memcpy(invalid_key, pub_key, sizeof(invalid_key));
+  // Moves the point off the curve
+  invalid_key[64] ^= 0x01;
+  TEST_ASSERT_NOT_EQUAL(
+      0, ecdsa_pubkey_table_init(&nist256p1, invalid_key, &table));
+}
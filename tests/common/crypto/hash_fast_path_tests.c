@@ -0,0 +1,250 @@
+/**
+ * @file    hash_fast_path_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the fixed-length SHA-256 and HASH160 paths
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "hasher.h"
+#include "ripemd160.h"
+#include "sha2.h"
+#include "unity_fixture.h"
+
+typedef void (*sha512_transform_fn)(const uint64_t *state_in,
+                                    const uint64_t *data,
+                                    uint64_t *state_out);
+
+static uint8_t message[SHA256_BLOCK_LENGTH];
+
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL,
+    0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL,
+    0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL,
+    0x5be0cd19137e2179ULL,
+};
+
+/**
+ * Hashes a message of up to two blocks through a bare SHA-512 transform so
+ * that a core can be checked against the FIPS 180 vectors on its own.
+ */
+static void sha512_with_transform(sha512_transform_fn transform,
+                                  const char *msg,
+                                  uint8_t digest[SHA512_DIGEST_LENGTH]) {
+  uint8_t padded[2 * SHA512_BLOCK_LENGTH] = {0};
+  uint64_t words[2 * SHA512_BLOCK_LENGTH / sizeof(uint64_t)] = {0};
+  uint64_t state[8] = {0};
+  size_t len = strlen(msg);
+  size_t blocks = (len + 1 + 16 > SHA512_BLOCK_LENGTH) ? 2 : 1;
+  uint64_t bits = (uint64_t)len * 8;
+
+  TEST_ASSERT_TRUE(len + 1 + 16 <= sizeof(padded));
+  memcpy(padded, msg, len);
+  padded[len] = 0x80;
+  for (size_t i = 0; i < sizeof(bits); i++) {
+    padded[blocks * SHA512_BLOCK_LENGTH - 1 - i] = (uint8_t)(bits >> (8 * i));
+  }
+  for (size_t i = 0; i < blocks * SHA512_BLOCK_LENGTH; i++) {
+    words[i / 8] = (words[i / 8] << 8) | padded[i];
+  }
+
+  memcpy(state, sha512_iv, sizeof(state));
+  for (size_t i = 0; i < blocks; i++) {
+    transform(state, &words[i * SHA512_BLOCK_LENGTH / 8], state);
+  }
+  for (size_t i = 0; i < SHA512_DIGEST_LENGTH; i++) {
+    digest[i] = (uint8_t)(state[i / 8] >> (56 - 8 * (i % 8)));
+  }
+}
+
+TEST_GROUP(hash_fast_path_tests);
+
+TEST_SETUP(hash_fast_path_tests) {
+  for (uint8_t i = 0; i < sizeof(message); i++) {
+    message[i] = i * 13 + 5;
+  }
+}
+
+TEST_TEAR_DOWN(hash_fast_path_tests) {
+  return;
+}
+
+TEST(hash_fast_path_tests, sha256_short_matches_generic) {
+  uint8_t expected[SHA256_DIGEST_LENGTH];
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+
+  for (size_t len = 0; len <= SHA256_SHORT_MAX_LENGTH; len++) {
+    sha256_Raw(message, len, expected);
+    sha256_Raw_short(message, len, digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+
+    sha256_Raw(expected, sizeof(expected), expected);
+    sha256d_short(message, len, digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+  }
+
+  // Inputs longer than one block take the generic path
+  sha256_Raw(message, sizeof(message), expected);
+  sha256_Raw(expected, sizeof(expected), expected);
+  sha256d_short(message, sizeof(message), digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+}
+
+TEST(hash_fast_path_tests, sha256_fixed_lengths) {
+  uint8_t expected[SHA256_DIGEST_LENGTH];
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+
+  sha256_Raw(message, 32, expected);
+  sha256_32(message, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+
+  sha256_Raw(message, 33, expected);
+  sha256_33(message, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+
+  // In-place hashing as used by the double-SHA256 call sites
+  sha256_Raw(expected, sizeof(expected), expected);
+  sha256_32(digest, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+
+  sha256_Raw(message, 32, expected);
+  sha256_Raw(expected, sizeof(expected), expected);
+  sha256d_32(message, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+}
+
+TEST(hash_fast_path_tests, hash160_matches_generic) {
+  uint8_t sha[SHA256_DIGEST_LENGTH];
+  uint8_t expected[RIPEMD160_DIGEST_LENGTH];
+  uint8_t digest[HASHER_DIGEST_LENGTH];
+
+  ripemd160(message, 32, expected);
+  ripemd160_32(message, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+
+  sha256_Raw(message, 33, sha);
+  ripemd160(sha, sizeof(sha), expected);
+  hash160_33(message, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+
+  hasher_Raw(HASHER_SHA2_RIPEMD, message, 33, digest);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(expected));
+}
+
+TEST(hash_fast_path_tests, sha512_32_matches_generic) {
+  uint64_t state[8], data[16], expected[8], digest[8];
+  uint64_t seed = 0x0123456789abcdefULL;
+
+  for (int round = 0; round < 500; round++) {
+    for (int i = 0; i < 8; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      state[i] = seed;
+    }
+    for (int i = 0; i < 16; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      data[i] = seed;
+    }
+
+    sha512_Transform(state, data, expected);
+    sha512_Transform_32(state, data, digest);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(expected));
+    sha512_Transform_32_unrolled(state, data, digest);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(expected));
+  }
+
+  // In-place transform as done by sha512_Update()
+  memcpy(digest, state, sizeof(digest));
+  sha512_Transform_32(digest, data, digest);
+  TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(expected));
+}
+
+TEST(hash_fast_path_tests, sha512_32_fips_vectors) {
+  // FIPS 180-2 appendix C: one block and two block messages
+  const char *messages[] = {
+      "abc",
+      "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+      "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+  };
+  const uint8_t expected[][SHA512_DIGEST_LENGTH] = {
+      {0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73,
+       0x49, 0xae, 0x20, 0x41, 0x31, 0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9,
+       0x7e, 0xa2, 0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a, 0x21,
+       0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23,
+       0xa3, 0xfe, 0xeb, 0xbd, 0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8,
+       0x0e, 0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f},
+      {0x8e, 0x95, 0x9b, 0x75, 0xda, 0xe3, 0x13, 0xda, 0x8c, 0xf4, 0xf7,
+       0x28, 0x14, 0xfc, 0x14, 0x3f, 0x8f, 0x77, 0x79, 0xc6, 0xeb, 0x9f,
+       0x7f, 0xa1, 0x72, 0x99, 0xae, 0xad, 0xb6, 0x88, 0x90, 0x18, 0x50,
+       0x1d, 0x28, 0x9e, 0x49, 0x00, 0xf7, 0xe4, 0x33, 0x1b, 0x99, 0xde,
+       0xc4, 0xb5, 0x43, 0x3a, 0xc7, 0xd3, 0x29, 0xee, 0xb6, 0xdd, 0x26,
+       0x54, 0x5e, 0x96, 0xe5, 0x5b, 0x87, 0x4b, 0xe9, 0x09},
+  };
+  uint8_t digest[SHA512_DIGEST_LENGTH];
+
+  for (size_t i = 0; i < sizeof(messages) / sizeof(messages[0]); i++) {
+    sha512_Raw((const uint8_t *)messages[i], strlen(messages[i]), digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[i], digest, sizeof(digest));
+
+    sha512_with_transform(sha512_Transform_32, messages[i], digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[i], digest, sizeof(digest));
+
+    sha512_with_transform(sha512_Transform_32_unrolled, messages[i], digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[i], digest, sizeof(digest));
+  }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file    rfc6979_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Tests for the RFC 6979 nonce generation
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "ecdsa.h"
+#include "rfc6979.h"
+#include "secp256k1.h"
+#include "sha2.h"
+#include "unity_fixture.h"
+#include "utils.h"
+
+typedef struct {
+  const char *priv_key;
+  const char *message;
+  const char *k;
+} rfc6979_vector_t;
+
+// secp256k1 with SHA-256
+static const rfc6979_vector_t vectors[] = {
+    {"cca9fbcc1b41e5a95d369eaa6ddcff73b61a4efaa279cfc6567e8daa39cbaf50",
+     "sample",
+     "2df40ca70e639d89528a6b670d9d48d9165fdc0febc0974056bdce192b8e16a3"},
+    {"0000000000000000000000000000000000000000000000000000000000000001",
+     "Satoshi Nakamoto",
+     "8f8a276c19f4149656b280621e358cce24f5f52542772691ee69063b74f15d15"},
+};
+
+TEST_GROUP(rfc6979_tests);
+
+TEST_SETUP(rfc6979_tests) {
+  return;
+}
+
+TEST_TEAR_DOWN(rfc6979_tests) {
+  return;
+}
+
+TEST(rfc6979_tests, known_vectors) {
+  uint8_t priv_key[32];
+  uint8_t hash[SHA256_DIGEST_LENGTH];
+  uint8_t expected[32];
+  uint8_t k[32];
+  rfc6979_key_state key;
+  rfc6979_state rng;
+
+  for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+    hex_string_to_byte_array(vectors[i].priv_key, 64, priv_key);
+    hex_string_to_byte_array(vectors[i].k, 64, expected);
+    sha256_Raw((const uint8_t *)vectors[i].message,
+               strlen(vectors[i].message),
+               hash);
+
+    init_rfc6979(priv_key, hash, &rng);
+    generate_rfc6979(k, &rng);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, k, sizeof(k));
+
+    init_rfc6979_key(priv_key, &key);
+    init_rfc6979_prepared(&key, hash, &rng);
+    generate_rfc6979(k, &rng);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, k, sizeof(k));
+  }
+}
+
+TEST(rfc6979_tests, prepared_key_signs_many_digests) {
+  uint8_t priv_key[32];
+  uint8_t hash[SHA256_DIGEST_LENGTH];
+  uint8_t expected[64];
+  uint8_t sig[64];
+  uint8_t expected_by = 0;
+  uint8_t by = 0;
+  rfc6979_key_state key;
+  rfc6979_state rng;
+  rfc6979_state prepared_rng;
+
+  hex_string_to_byte_array(vectors[0].priv_key, 64, priv_key);
+  init_rfc6979_key(priv_key, &key);
+
+  for (uint8_t i = 0; i < 8; i++) {
+    memset(hash, i, sizeof(hash));
+
+    // every generated number matches, not only the first one
+    init_rfc6979(priv_key, hash, &rng);
+    init_rfc6979_prepared(&key, hash, &prepared_rng);
+    for (int j = 0; j < 3; j++) {
+      generate_rfc6979(expected, &rng);
+      generate_rfc6979(sig, &prepared_rng);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, sig, 32);
+    }
+
+    TEST_ASSERT_EQUAL(
+        0,
+        ecdsa_sign_digest(
+            &secp256k1, priv_key, hash, expected, &expected_by, NULL));
+    TEST_ASSERT_EQUAL(
+        0,
+        ecdsa_sign_digest_prepared(&secp256k1, &key, hash, sig, &by, NULL));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, sig, sizeof(sig));
+    TEST_ASSERT_EQUAL_UINT8(expected_by, by);
+  }
+}
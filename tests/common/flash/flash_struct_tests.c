@@ -0,0 +1,108 @@
+/**
+ * @file    flash_struct_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the flash structure serialization
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "flash_struct.h"
+#include "unity_fixture.h"
+
+uint16_t serialize_fs(const Flash_Struct *flash_struct, uint8_t *tlv);
+void deserialize_fs(Flash_Struct *flash_struct, uint8_t *tlv);
+
+// Larger than the TLV as each field adds only 3 bytes of tag and length
+static uint8_t tlv[2 * sizeof(Flash_Struct)];
+static Flash_Struct input;
+static Flash_Struct output;
+
+TEST_GROUP(flash_struct_tests);
+
+TEST_SETUP(flash_struct_tests) {
+  memset(tlv, 0, sizeof(tlv));
+  memset(&input, 0, sizeof(input));
+  memset(&output, 0, sizeof(output));
+}
+
+TEST_TEAR_DOWN(flash_struct_tests) {
+  return;
+}
+
+TEST(flash_struct_tests, seed_tag_round_trip) {
+  input.wallet_count = MAX_WALLETS_ALLOWED;
+  for (uint8_t i = 0; i < MAX_WALLETS_ALLOWED; i++) {
+    input.wallets[i].state = VALID_WALLET;
+    memset(input.wallets[i].wallet_id, 0x10 + i, WALLET_ID_SIZE);
+    for (uint8_t j = 0; j < WALLET_SEED_TAG_SIZE; j++) {
+      input.wallets[i].seed_tag[j] = (uint8_t)(i * WALLET_SEED_TAG_SIZE + j);
+    }
+  }
+
+  uint16_t size = serialize_fs(&input, tlv);
+  TEST_ASSERT_LESS_OR_EQUAL(sizeof(tlv), size);
+
+  deserialize_fs(&output, tlv);
+
+  TEST_ASSERT_EQUAL(input.wallet_count, output.wallet_count);
+  for (uint8_t i = 0; i < MAX_WALLETS_ALLOWED; i++) {
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input.wallets[i].wallet_id,
+                                  output.wallets[i].wallet_id,
+                                  WALLET_ID_SIZE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input.wallets[i].seed_tag,
+                                  output.wallets[i].seed_tag,
+                                  WALLET_SEED_TAG_SIZE);
+  }
+}
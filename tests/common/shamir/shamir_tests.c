@@ -0,0 +1,219 @@
+/**
+ * @file    shamir_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the streaming shamir split and recovery
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include "shamir_wrapper.h"
+#include "unity_fixture.h"
+#include "utils.h"
+
+#define SHAMIR_TEST_CARDS 4
+
+// Odd length so that the final block (5 bytes) is partial and odd-sized
+static uint8_t secret[101];
+static uint8_t shares[SHAMIR_TEST_CARDS][sizeof(secret)];
+static uint8_t x_coords[SHAMIR_TEST_CARDS] = {1, 2, 3, 4};
+static shamir_stream_ctx_t stream_ctx;
+
+/**
+ * @brief Multiplies in GF(2^8) with the polynomial of the galois tables used
+ * by shamir_wrapper (x^8 + x^4 + x^3 + x + 1)
+ */
+static uint8_t gf_mul(uint8_t a, uint8_t b) {
+  uint8_t result = 0;
+
+  while (0 < b) {
+    if (b & 1) {
+      result ^= a;
+    }
+    a = (a << 1) ^ ((a & 0x80) ? 0x1B : 0x00);
+    b >>= 1;
+  }
+  return result;
+}
+
+static uint8_t gf_inv(uint8_t a) {
+  uint8_t result = 1;
+
+  // a^254 is the inverse of a
+  for (uint8_t i = 0; i < 254; i++) {
+    result = gf_mul(result, a);
+  }
+  return result;
+}
+
+/**
+ * @brief Recovers the secret by Lagrange interpolation at x = 0 over the cards
+ * selected in the mask, for any threshold
+ */
+static void recover_from_cards(uint8_t card_mask, uint8_t recovered[]) {
+  memzero(recovered, sizeof(secret));
+  for (uint8_t i = 0; i < SHAMIR_TEST_CARDS; i++) {
+    uint8_t basis = 1;
+
+    if (0 == (card_mask & (1 << i))) {
+      continue;
+    }
+    for (uint8_t j = 0; j < SHAMIR_TEST_CARDS; j++) {
+      if (j == i || 0 == (card_mask & (1 << j))) {
+        continue;
+      }
+      basis = gf_mul(basis,
+                     gf_mul(x_coords[j], gf_inv(x_coords[j] ^ x_coords[i])));
+    }
+    for (uint8_t k = 0; k < sizeof(secret); k++) {
+      recovered[k] ^= gf_mul(shares[i][k], basis);
+    }
+  }
+}
+
+static uint8_t count_cards(uint8_t card_mask) {
+  uint8_t count = 0;
+
+  for (; 0 < card_mask; card_mask >>= 1) {
+    count += card_mask & 1;
+  }
+  return count;
+}
+
+static void split_and_recover(uint8_t threshold) {
+  uint8_t recovered[sizeof(secret)];
+
+  shamir_stream_init(&stream_ctx, threshold);
+  for (uint8_t i = 0; i < SHAMIR_TEST_CARDS; i++) {
+    shamir_stream_split(
+        &stream_ctx, sizeof(secret), secret, x_coords[i], shares[i]);
+  }
+
+  for (uint8_t mask = 1; mask < (1 << SHAMIR_TEST_CARDS); mask++) {
+    recover_from_cards(mask, recovered);
+    if (count_cards(mask) >= threshold) {
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(secret, recovered, sizeof(secret));
+    } else {
+      // Too few shares must not reveal the secret
+      TEST_ASSERT_NOT_EQUAL(0, memcmp(secret, recovered, sizeof(secret)));
+    }
+  }
+}
+
+TEST_GROUP(shamir_tests);
+
+TEST_SETUP(shamir_tests) {
+  for (uint8_t i = 0; i < sizeof(secret); i++) {
+    secret[i] = i * 7 + 3;
+  }
+
+  shamir_stream_init(&stream_ctx, MINIMUM_NO_OF_SHARES);
+  for (uint8_t i = 0; i < SHAMIR_TEST_CARDS; i++) {
+    shamir_stream_split(
+        &stream_ctx, sizeof(secret), secret, x_coords[i], shares[i]);
+  }
+}
+
+TEST_TEAR_DOWN(shamir_tests) {
+  memzero(secret, sizeof(secret));
+  memzero(shares, sizeof(shares));
+  memzero(&stream_ctx, sizeof(stream_ctx));
+}
+
+TEST(shamir_tests, stream_split_recover_pairs) {
+  uint8_t two_shares[MINIMUM_NO_OF_SHARES][sizeof(secret)];
+  uint8_t two_x_coords[MINIMUM_NO_OF_SHARES];
+  uint8_t recovered[sizeof(secret)];
+
+  // Any two shares must recover the secret through the existing recovery
+  for (uint8_t i = 0; i < SHAMIR_TEST_CARDS; i++) {
+    for (uint8_t j = i + 1; j < SHAMIR_TEST_CARDS; j++) {
+      memcpy(two_shares[0], shares[i], sizeof(secret));
+      memcpy(two_shares[1], shares[j], sizeof(secret));
+      two_x_coords[0] = x_coords[i];
+      two_x_coords[1] = x_coords[j];
+      recover_secret_from_shares(sizeof(secret),
+                                 MINIMUM_NO_OF_SHARES,
+                                 two_shares,
+                                 two_x_coords,
+                                 recovered);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(secret, recovered, sizeof(secret));
+    }
+  }
+}
+
+TEST(shamir_tests, stream_split_is_deterministic_per_block) {
+  uint8_t share[SHAMIR_STREAM_BLOCK_SIZE];
+
+  // The last (partial) block of card 3 computed on its own
+  shamir_stream_split_block(&stream_ctx,
+                            3,
+                            sizeof(secret) - 3 * SHAMIR_STREAM_BLOCK_SIZE,
+                            secret + 3 * SHAMIR_STREAM_BLOCK_SIZE,
+                            x_coords[2],
+                            share);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(shares[2] + 3 * SHAMIR_STREAM_BLOCK_SIZE,
+                                share,
+                                sizeof(secret) - 3 * SHAMIR_STREAM_BLOCK_SIZE);
+}
+
+TEST(shamir_tests, stream_split_threshold_2) {
+  split_and_recover(2);
+}
+
+TEST(shamir_tests, stream_split_threshold_3) {
+  split_and_recover(3);
+}
+
+TEST(shamir_tests, stream_split_threshold_4) {
+  split_and_recover(4);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file    lz4_block_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the LZ4 block decoder
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "lz4_block.h"
+#include "unity_fixture.h"
+#include "utils.h"
+
+// Eight transaction outputs sharing the same P2PKH script
+#define REPEATED_SCRIPTS_BLOCK                                                 \
+  "410050c3000100ff0d1976a9149e8bf5383534bbcdecbf2f25e1c61d50ccab94de88ac01"   \
+  "5123000e2f025223000e2f035323000e2f045423000e2f055523000e2f065623000e2f07"   \
+  "5723000950ab94de88ac"
+// ERC-20 transfer calldata padded with zero words
+#define ZERO_PADDING_BLOCK                                                     \
+  "57a9059cbb0001001fab010000071f000f0b00011f011500010f140014500000000000"
+
+static void build_repeated_scripts(uint8_t *data) {
+  uint8_t script[25] = {0};
+  hex_string_to_byte_array(
+      "76a9149e8bf5383534bbcdecbf2f25e1c61d50ccab94de88ac", 50, script);
+
+  for (uint8_t i = 0; i < 8; i++) {
+    uint8_t *output = data + i * 35;
+    output[0] = i;
+    memset(output + 1, 0, 8);
+    output[1] = 0x50 + i;
+    output[2] = 0xC3;
+    output[9] = sizeof(script);
+    memcpy(output + 10, script, sizeof(script));
+  }
+}
+
+static void build_zero_padding(uint8_t *data) {
+  memset(data, 0, 132);
+  hex_string_to_byte_array("a9059cbb", 8, data);
+  memset(data + 16, 0xAB, 20);
+  data[67] = 0x01;
+}
+
+TEST_GROUP(lz4_block_tests);
+
+TEST_SETUP(lz4_block_tests) {
+  return;
+}
+
+TEST_TEAR_DOWN(lz4_block_tests) {
+  return;
+}
+
+TEST(lz4_block_tests, decompress_repeated_scripts) {
+  uint8_t block[82] = {0};
+  uint8_t expected[280] = {0};
+  uint8_t output[300] = {0};
+
+  hex_string_to_byte_array(REPEATED_SCRIPTS_BLOCK, 164, block);
+  build_repeated_scripts(expected);
+
+  TEST_ASSERT_EQUAL_INT32(
+      sizeof(expected),
+      lz4_block_decompress(block, sizeof(block), output, sizeof(output)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+}
+
+TEST(lz4_block_tests, decompress_in_place) {
+  uint8_t expected[132] = {0};
+  uint8_t buffer[132 + 32] = {0};
+  uint8_t *block = buffer + sizeof(buffer) - 35;
+
+  hex_string_to_byte_array(ZERO_PADDING_BLOCK, 70, block);
+  build_zero_padding(expected);
+
+  TEST_ASSERT_EQUAL_INT32(
+      sizeof(expected),
+      lz4_block_decompress(block, 35, buffer, sizeof(buffer)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(expected));
+}
+
+TEST(lz4_block_tests, decompress_in_place_overrun) {
+  // the output would overwrite the block before it is consumed
+  uint8_t buffer[132] = {0};
+  uint8_t *block = buffer + sizeof(buffer) - 35;
+
+  hex_string_to_byte_array(ZERO_PADDING_BLOCK, 70, block);
+  TEST_ASSERT_EQUAL_INT32(
+      LZ4_BLOCK_ERROR, lz4_block_decompress(block, 35, buffer, sizeof(buffer)));
+}
+
+TEST(lz4_block_tests, decompress_invalid_offset) {
+  // one literal followed by a match 5 bytes back
+  const uint8_t block[] = {0x10, 'a', 0x05, 0x00};
+  uint8_t output[32] = {0};
+
+  TEST_ASSERT_EQUAL_INT32(
+      LZ4_BLOCK_ERROR,
+      lz4_block_decompress(block, sizeof(block), output, sizeof(output)));
+}
+
+TEST(lz4_block_tests, decompress_output_too_small) {
+  uint8_t block[82] = {0};
+  uint8_t output[279] = {0};
+
+  hex_string_to_byte_array(REPEATED_SCRIPTS_BLOCK, 164, block);
+  TEST_ASSERT_EQUAL_INT32(
+      LZ4_BLOCK_ERROR,
+      lz4_block_decompress(block, sizeof(block), output, sizeof(output)));
+}
+
+TEST(lz4_block_tests, decompress_truncated) {
+  uint8_t block[82] = {0};
+  uint8_t output[300] = {0};
+
+  hex_string_to_byte_array(REPEATED_SCRIPTS_BLOCK, 164, block);
+  // ends within the literals of the second sequence
+  TEST_ASSERT_EQUAL_INT32(
+      LZ4_BLOCK_ERROR, lz4_block_decompress(block, 20, output, sizeof(output)));
+}
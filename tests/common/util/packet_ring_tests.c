@@ -0,0 +1,218 @@
+/**
+ * @file    packet_ring_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the single-producer/single-consumer packet ring
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "packet_ring.h"
+#include "unity_fixture.h"
+
+#if USE_SIMULATOR == 1
+#include <pthread.h>
+#endif
+
+#define TEST_SLOT_SIZE 64
+#define TEST_SLOT_COUNT 4
+#define TEST_STREAM_PACKETS 2000
+
+static uint8_t ring_buffer[TEST_SLOT_COUNT * TEST_SLOT_SIZE];
+static packet_ring_slot_t ring_slots[TEST_SLOT_COUNT];
+static packet_ring_t ring;
+
+static void fill_packet(uint8_t *packet, uint16_t length, uint32_t seq) {
+  for (uint16_t i = 0; i < length; i++) {
+    packet[i] = (uint8_t)(seq + i);
+  }
+}
+
+static bool check_packet(const uint8_t *packet,
+                         uint16_t length,
+                         uint32_t seq) {
+  for (uint16_t i = 0; i < length; i++) {
+    if (packet[i] != (uint8_t)(seq + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if USE_SIMULATOR == 1
+// Emulates the USB interrupt pushing packets while the test consumes them
+static void *producer_thread(void *arg) {
+  uint8_t packet[TEST_SLOT_SIZE] = {0};
+  (void)arg;
+
+  for (uint32_t seq = 0; seq < TEST_STREAM_PACKETS;) {
+    const uint16_t length = 1 + (seq % TEST_SLOT_SIZE);
+    fill_packet(packet, length, seq);
+    // retry while the ring is full so that every packet is delivered
+    if (packet_ring_push(&ring, (uint8_t)seq, packet, length)) {
+      seq++;
+    }
+  }
+  return NULL;
+}
+#endif
+
+TEST_GROUP(packet_ring_tests);
+
+TEST_SETUP(packet_ring_tests) {
+  memset(ring_buffer, 0, sizeof(ring_buffer));
+  memset(ring_slots, 0, sizeof(ring_slots));
+  memset(&ring, 0, sizeof(ring));
+  ring.buffer = ring_buffer;
+  ring.slots = ring_slots;
+  ring.slot_size = TEST_SLOT_SIZE;
+  ring.slot_count = TEST_SLOT_COUNT;
+}
+
+TEST_TEAR_DOWN(packet_ring_tests) {
+  return;
+}
+
+TEST(packet_ring_tests, fifo_order) {
+  uint8_t packet[TEST_SLOT_SIZE] = {0};
+  const uint8_t *data = NULL;
+  uint16_t length = 0;
+  uint8_t tag = 0;
+
+  // wrap around the ring a few times
+  for (uint32_t seq = 0; seq < 3 * TEST_SLOT_COUNT; seq += 2) {
+    fill_packet(packet, 10, seq);
+    TEST_ASSERT_TRUE(packet_ring_push(&ring, 1, packet, 10));
+    fill_packet(packet, TEST_SLOT_SIZE, seq + 1);
+    TEST_ASSERT_TRUE(packet_ring_push(&ring, 2, packet, TEST_SLOT_SIZE));
+
+    TEST_ASSERT_TRUE(packet_ring_peek(&ring, &tag, &data, &length));
+    TEST_ASSERT_EQUAL_UINT8(1, tag);
+    TEST_ASSERT_EQUAL_UINT16(10, length);
+    TEST_ASSERT_TRUE(check_packet(data, length, seq));
+    packet_ring_pop(&ring);
+
+    TEST_ASSERT_TRUE(packet_ring_peek(&ring, &tag, &data, &length));
+    TEST_ASSERT_EQUAL_UINT8(2, tag);
+    TEST_ASSERT_EQUAL_UINT16(TEST_SLOT_SIZE, length);
+    TEST_ASSERT_TRUE(check_packet(data, length, seq + 1));
+    packet_ring_pop(&ring);
+  }
+
+  TEST_ASSERT_FALSE(packet_ring_peek(&ring, &tag, &data, &length));
+  TEST_ASSERT_EQUAL_UINT32(0, packet_ring_get_overflow_count(&ring));
+}
+
+TEST(packet_ring_tests, overflow_drops_newest) {
+  uint8_t packet[TEST_SLOT_SIZE + 1] = {0};
+  const uint8_t *data = NULL;
+  uint16_t length = 0;
+  uint8_t tag = 0;
+
+  for (uint8_t i = 0; i < TEST_SLOT_COUNT; i++) {
+    TEST_ASSERT_TRUE(packet_ring_push(&ring, i, packet, 1));
+  }
+  TEST_ASSERT_FALSE(packet_ring_push(&ring, 0xFF, packet, 1));
+  TEST_ASSERT_EQUAL_UINT32(1, packet_ring_get_overflow_count(&ring));
+
+  // queued packets are intact and in order
+  for (uint8_t i = 0; i < TEST_SLOT_COUNT; i++) {
+    TEST_ASSERT_TRUE(packet_ring_peek(&ring, &tag, &data, &length));
+    TEST_ASSERT_EQUAL_UINT8(i, tag);
+    packet_ring_pop(&ring);
+  }
+
+  // oversized packets are dropped even when there is room
+  TEST_ASSERT_FALSE(packet_ring_push(&ring, 0, packet, sizeof(packet)));
+  TEST_ASSERT_EQUAL_UINT32(2, packet_ring_get_overflow_count(&ring));
+  TEST_ASSERT_FALSE(packet_ring_peek(&ring, &tag, &data, &length));
+}
+
+TEST(packet_ring_tests, pop_empty) {
+  const uint8_t *data = NULL;
+  uint16_t length = 0;
+  uint8_t tag = 0;
+
+  packet_ring_pop(&ring);
+  TEST_ASSERT_FALSE(packet_ring_peek(&ring, &tag, &data, &length));
+  TEST_ASSERT_TRUE(packet_ring_push(&ring, 7, NULL, 0));
+  TEST_ASSERT_TRUE(packet_ring_peek(&ring, &tag, &data, &length));
+  TEST_ASSERT_EQUAL_UINT8(7, tag);
+  TEST_ASSERT_EQUAL_UINT16(0, length);
+}
+
+#if USE_SIMULATOR == 1
+TEST(packet_ring_tests, concurrent_producer) {
+  pthread_t producer;
+  const uint8_t *data = NULL;
+  uint16_t length = 0;
+  uint8_t tag = 0;
+  uint32_t seq = 0;
+
+  TEST_ASSERT_EQUAL_INT(
+      0, pthread_create(&producer, NULL, producer_thread, NULL));
+  while (seq < TEST_STREAM_PACKETS) {
+    if (!packet_ring_peek(&ring, &tag, &data, &length)) {
+      continue;
+    }
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)seq, tag);
+    TEST_ASSERT_EQUAL_UINT16(1 + (seq % TEST_SLOT_SIZE), length);
+    TEST_ASSERT_TRUE(check_packet(data, length, seq));
+    packet_ring_pop(&ring);
+    seq++;
+  }
+  pthread_join(producer, NULL);
+  TEST_ASSERT_FALSE(packet_ring_peek(&ring, &tag, &data, &length));
+}
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file    wallet_utilities_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Unit tests for the wallet utilities
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+
+#include "unity_fixture.h"
+#include "utils.h"
+#include "wallet_utilities.h"
+
+// Entropy of a 12 word mnemonic
+static const char *entropy_hex = "7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f";
+
+TEST_GROUP(wallet_utilities_tests);
+
+TEST_SETUP(wallet_utilities_tests) {
+  return;
+}
+
+TEST_TEAR_DOWN(wallet_utilities_tests) {
+  return;
+}
+
+TEST(wallet_utilities_tests, seed_tag_known_vector) {
+  uint8_t wallet_id[WALLET_ID_SIZE] = {0};
+  uint8_t entropy[16] = {0};
+  uint8_t expected[WALLET_SEED_TAG_SIZE] = {0};
+  uint8_t seed_tag[WALLET_SEED_TAG_SIZE] = {0};
+
+  for (uint8_t i = 0; i < WALLET_ID_SIZE; i++) {
+    wallet_id[i] = i;
+  }
+  hex_string_to_byte_array(entropy_hex, 32, entropy);
+  // HMAC-SHA256(key = wallet id, "X1 wallet seed tag" || entropy)
+  hex_string_to_byte_array(
+      "34c3e9f78cf4e4e107a627b8b06903408520b4f2d9b3230f12c7a5af401cced9",
+      64,
+      expected);
+
+  calculate_seed_tag(wallet_id, entropy, sizeof(entropy), seed_tag);
+
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, seed_tag, WALLET_SEED_TAG_SIZE);
+}
+
+TEST(wallet_utilities_tests, seed_tag_keyed_by_wallet_id) {
+  uint8_t wallet_id[WALLET_ID_SIZE] = {0};
+  uint8_t entropy[16] = {0};
+  uint8_t expected[WALLET_SEED_TAG_SIZE] = {0};
+  uint8_t seed_tag[WALLET_SEED_TAG_SIZE] = {0};
+
+  // Same entropy as the known vector under another wallet id
+  for (uint8_t i = 0; i < WALLET_ID_SIZE; i++) {
+    wallet_id[i] = i + 1;
+  }
+  hex_string_to_byte_array(entropy_hex, 32, entropy);
+  hex_string_to_byte_array(
+      "52df50921168fc8d7de1c1665b6385dabf5de0d3ba28f03f32835ea1b3cfa728",
+      64,
+      expected);
+
+  calculate_seed_tag(wallet_id, entropy, sizeof(entropy), seed_tag);
+
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, seed_tag, WALLET_SEED_TAG_SIZE);
+}
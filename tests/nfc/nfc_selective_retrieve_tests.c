@@ -0,0 +1,210 @@
+/**
+ * @file    nfc_selective_retrieve_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Selective retrieve wallet tests
+ *          Exercises the field mask of retrieve wallet and the fallback to the
+ *          full retrieve against the emulated card of the simulator
+ *
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+#include <string.h>
+
+#include "apdu.h"
+#include "flash_if.h"
+#include "nfc.h"
+#include "unity_fixture.h"
+
+#if USE_SIMULATOR == 1
+#include "applet.h"
+
+static Wallet stored;
+static Wallet retrieved;
+
+static void select_card(void) {
+  uint8_t family_id[FAMILY_ID_SIZE + 2];
+  uint8_t acceptable_cards = 15;
+
+  memset(family_id, DEFAULT_VALUE_IN_FLASH, sizeof(family_id));
+  TEST_ASSERT_EQUAL(STM_SUCCESS, nfc_select_card());
+  TEST_ASSERT_EQUAL_HEX16(
+      SW_NO_ERROR,
+      nfc_select_applet(family_id, &acceptable_cards, NULL, NULL, NULL));
+}
+
+static void add_wallet(void) {
+  // leftovers of an interrupted run would occupy the slot of the card
+  nfc_delete_wallet(&stored);
+  TEST_ASSERT_EQUAL_HEX16(SW_NO_ERROR, nfc_add_wallet(&stored));
+}
+
+static void retrieve_wallet(void) {
+  memcpy(retrieved.wallet_name, stored.wallet_name, NAME_SIZE);
+  TEST_ASSERT_EQUAL_HEX16(
+      SW_NO_ERROR,
+      nfc_retrieve_wallet_fields(&retrieved, WALLET_FIELDS_FOR_SHARE));
+
+  TEST_ASSERT_EQUAL(stored.xcor, retrieved.xcor);
+  TEST_ASSERT_EQUAL(stored.number_of_mnemonics, retrieved.number_of_mnemonics);
+  TEST_ASSERT_EQUAL(stored.wallet_info, retrieved.wallet_info);
+  TEST_ASSERT_EQUAL_MEMORY(stored.wallet_share_with_mac_and_nonce,
+                           retrieved.wallet_share_with_mac_and_nonce,
+                           sizeof(stored.wallet_share_with_mac_and_nonce));
+  TEST_ASSERT_EQUAL_MEMORY(
+      stored.wallet_id, retrieved.wallet_id, WALLET_ID_SIZE);
+}
+
+TEST_GROUP(nfc_selective_retrieve_test);
+
+TEST_SETUP(nfc_selective_retrieve_test) {
+  uint8_t enc_key[32], mac_key[32];
+
+  for (int i = 0; i < 32; i++) {
+    enc_key[i] = i;
+    mac_key[i] = 0xA0 + i;
+  }
+  applet_enable_secure_channel(enc_key, mac_key);
+  init_session_keys(enc_key, mac_key, NULL);
+
+  memset(&stored, 0, sizeof(stored));
+  memset(&retrieved, 0, sizeof(retrieved));
+  strcpy((char *)stored.wallet_name, "SELECTIVE");
+  stored.xcor = 1;
+  stored.number_of_mnemonics = 24;
+  stored.total_number_of_shares = TOTAL_NUMBER_OF_SHARES;
+  stored.minimum_number_of_shares = MINIMUM_NO_OF_SHARES;
+  memset(stored.wallet_share_with_mac_and_nonce,
+         0x5A,
+         sizeof(stored.wallet_share_with_mac_and_nonce));
+  memset(stored.key, 0x6B, sizeof(stored.key));
+  memset(stored.beneficiary_key, 0x7C, sizeof(stored.beneficiary_key));
+  memset(stored.iv_for_beneficiary_key,
+         0x7D,
+         sizeof(stored.iv_for_beneficiary_key));
+  memset(stored.wallet_id, 0x3C, WALLET_ID_SIZE);
+}
+
+TEST_TEAR_DOWN(nfc_selective_retrieve_test) {
+  applet_set_selective_retrieve(true);
+  nfc_delete_wallet(&stored);
+  nfc_set_secure_comm(false);
+}
+
+TEST(nfc_selective_retrieve_test, selected_fields_only) {
+  select_card();
+  TEST_ASSERT_BITS_HIGH(CARD_CAP_SELECTIVE_RETRIEVE,
+                        get_card_capabilities()->flags);
+  add_wallet();
+
+  retrieve_wallet();
+
+  // the beneficiary key and its IV are not part of the field mask
+  TEST_ASSERT_EACH_EQUAL_HEX8(
+      0, retrieved.beneficiary_key, sizeof(retrieved.beneficiary_key));
+  TEST_ASSERT_EACH_EQUAL_HEX8(0,
+                              retrieved.iv_for_beneficiary_key,
+                              sizeof(retrieved.iv_for_beneficiary_key));
+}
+
+TEST(nfc_selective_retrieve_test, full_retrieve_without_capability) {
+  applet_set_selective_retrieve(false);
+  select_card();
+  TEST_ASSERT_BITS_LOW(CARD_CAP_SELECTIVE_RETRIEVE,
+                       get_card_capabilities()->flags);
+  add_wallet();
+
+  retrieve_wallet();
+
+  TEST_ASSERT_EQUAL_MEMORY(stored.beneficiary_key,
+                           retrieved.beneficiary_key,
+                           sizeof(stored.beneficiary_key));
+}
+
+TEST(nfc_selective_retrieve_test, full_retrieve_on_unknown_p1) {
+  select_card();
+  add_wallet();
+
+  // the card advertised the capability yet rejects the selective P1
+  applet_set_selective_retrieve(false);
+  retrieve_wallet();
+
+  TEST_ASSERT_EQUAL_MEMORY(stored.beneficiary_key,
+                           retrieved.beneficiary_key,
+                           sizeof(stored.beneficiary_key));
+}
+
+TEST(nfc_selective_retrieve_test, selected_fields_checksum_verified) {
+  uint8_t apdu[600] = {0};
+  uint16_t recv_len = sizeof(apdu);
+
+  select_card();
+  nfc_delete_wallet(&stored);
+
+  // store the wallet with a checksum that does not match its fields
+  calculate_checksum(&stored, stored.checksum);
+  stored.checksum[0] ^= 0x01;
+  nfc_set_secure_comm(true);
+  TEST_ASSERT_EQUAL(STM_SUCCESS,
+                    nfc_exchange_apdu(apdu,
+                                      create_apdu_add_wallet(&stored, apdu),
+                                      apdu,
+                                      &recv_len));
+  TEST_ASSERT_EQUAL_HEX8(0x90, apdu[recv_len - 2]);
+
+  memcpy(retrieved.wallet_name, stored.wallet_name, NAME_SIZE);
+  TEST_ASSERT_NOT_EQUAL(
+      SW_NO_ERROR,
+      nfc_retrieve_wallet_fields(&retrieved, WALLET_FIELDS_FOR_SHARE));
+}
+#endif /* USE_SIMULATOR == 1 */
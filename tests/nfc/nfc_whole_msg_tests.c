@@ -0,0 +1,170 @@
+/**
+ * @file    nfc_whole_msg_tests.c
+ * @author  Cypherock X1 Team
+ * @brief   Whole-message secure channel tests
+ *          Exercises command chaining, chained responses and the frame size
+ *          negotiation against the emulated card of the simulator
+ *
+ * @copyright Copyright (c) 2023 HODL TECH PTE LTD
+ * <br/> You may obtain a copy of license at <a href="https://mitcc.org/"
+ *target=_blank>https://mitcc.org/</a>
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * (c) Copyright 2023 by HODL TECH PTE LTD
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * "Commons Clause" License Condition v1.0
+ *
+ * The Software is provided to you by the Licensor under the License,
+ * as defined below, subject to the following condition.
+ *
+ * Without limiting other conditions in the License, the grant of
+ * rights under the License will not include, and the License does not
+ * grant to you, the right to Sell the Software.
+ *
+ * For purposes of the foregoing, "Sell" means practicing any or all
+ * of the rights granted to you under the License to provide to third
+ * parties, for a fee or other consideration (including without
+ * limitation fees for hosting or consulting/ support services related
+ * to the Software), a product or service whose value derives, entirely
+ * or substantially, from the functionality of the Software. Any license
+ * notice or attribution required by the License must also include
+ * this Commons Clause License Condition notice.
+ *
+ * Software: All X1Wallet associated files.
+ * License: MIT
+ * Licensor: HODL TECH PTE LTD
+ *
+ ******************************************************************************
+ */
+#include "nfc.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "apdu.h"
+#include "flash_if.h"
+#include "unity_fixture.h"
+
+#if USE_SIMULATOR == 1
+#include "applet.h"
+
+#define WHOLE_MSG_TEST_WALLETS 2
+#define WALLET_LIST_ENTRY_LEN 56
+#define WALLET_LIST_NAME_OFFSET 4
+
+static Wallet wallets[WHOLE_MSG_TEST_WALLETS];
+
+static void prepare_wallets(void) {
+  memset(wallets, 0, sizeof(wallets));
+  for (int i = 0; i < WHOLE_MSG_TEST_WALLETS; i++) {
+    snprintf((char *)wallets[i].wallet_name, NAME_SIZE, "WHOLE MSG %d", i);
+    memset(wallets[i].wallet_id, 0x11 * (i + 1), WALLET_ID_SIZE);
+  }
+
+  // leftovers of an interrupted run would occupy the slots of the card
+  for (int i = 0; i < WHOLE_MSG_TEST_WALLETS; i++) {
+    nfc_delete_wallet(&wallets[i]);
+  }
+  for (int i = 0; i < WHOLE_MSG_TEST_WALLETS; i++) {
+    TEST_ASSERT_EQUAL_HEX16(SW_NO_ERROR, nfc_add_wallet(&wallets[i]));
+  }
+}
+
+TEST_GROUP(nfc_whole_msg_test);
+
+TEST_SETUP(nfc_whole_msg_test) {
+  uint8_t enc_key[32], mac_key[32];
+  uint8_t family_id[FAMILY_ID_SIZE + 2];
+  uint8_t acceptable_cards = 15;
+
+  for (int i = 0; i < 32; i++) {
+    enc_key[i] = i;
+    mac_key[i] = 0xA0 + i;
+  }
+  applet_enable_secure_channel(enc_key, mac_key);
+  init_session_keys(enc_key, mac_key, NULL);
+  memset(family_id, DEFAULT_VALUE_IN_FLASH, sizeof(family_id));
+
+  TEST_ASSERT_EQUAL(STM_SUCCESS, nfc_select_card());
+  TEST_ASSERT_EQUAL_HEX16(
+      SW_NO_ERROR,
+      nfc_select_applet(family_id, &acceptable_cards, NULL, NULL, NULL));
+  TEST_ASSERT_BITS_HIGH(CARD_CAP_WHOLE_MSG_SC,
+                        get_card_capabilities()->flags);
+  TEST_ASSERT_NOT_EQUAL(0, get_card_capabilities()->max_frame_len);
+}
+
+TEST_TEAR_DOWN(nfc_whole_msg_test) {
+  nfc_set_secure_comm(false);
+}
+
+TEST(nfc_whole_msg_test, chained_command_and_response) {
+  uint8_t apdu[600] = {0};
+  uint16_t recv_len = sizeof(apdu);
+
+  // an encrypted add wallet command exceeds a frame, so it is sent chained
+  prepare_wallets();
+
+  // the protected list exceeds a response frame of the card
+  nfc_set_secure_comm(true);
+  TEST_ASSERT_EQUAL(
+      STM_SUCCESS,
+      nfc_exchange_apdu(apdu, create_apdu_list_wallet(apdu), apdu, &recv_len));
+  TEST_ASSERT_EQUAL(1 + WHOLE_MSG_TEST_WALLETS * WALLET_LIST_ENTRY_LEN + 2,
+                    recv_len);
+  TEST_ASSERT_EQUAL(WHOLE_MSG_TEST_WALLETS, apdu[0]);
+  for (int i = 0; i < WHOLE_MSG_TEST_WALLETS; i++) {
+    TEST_ASSERT_EQUAL_MEMORY(
+        wallets[i].wallet_name,
+        apdu + 1 + i * WALLET_LIST_ENTRY_LEN + WALLET_LIST_NAME_OFFSET,
+        NAME_SIZE);
+  }
+  TEST_ASSERT_EQUAL_HEX8(0x90, apdu[recv_len - 2]);
+  TEST_ASSERT_EQUAL_HEX8(0x00, apdu[recv_len - 1]);
+
+  for (int i = 0; i < WHOLE_MSG_TEST_WALLETS; i++) {
+    TEST_ASSERT_EQUAL_HEX16(SW_NO_ERROR, nfc_delete_wallet(&wallets[i]));
+  }
+}
+
+TEST(nfc_whole_msg_test, response_bounded_by_capacity) {
+  uint8_t apdu[600];
+  const uint16_t capacity = 140;
+  uint16_t recv_len = capacity;
+
+  prepare_wallets();
+
+  // the chained response is larger than the capacity given by the caller
+  memset(apdu, 0xA5, sizeof(apdu));
+  nfc_set_secure_comm(true);
+  TEST_ASSERT_NOT_EQUAL(
+      STM_SUCCESS,
+      nfc_exchange_apdu(apdu, create_apdu_list_wallet(apdu), apdu, &recv_len));
+  for (uint16_t i = capacity; i < sizeof(apdu); i++) {
+    TEST_ASSERT_EQUAL_HEX8(0xA5, apdu[i]);
+  }
+}
+#endif /* USE_SIMULATOR == 1 */
@@ -61,6 +61,9 @@
  *****************************************************************************/
 #include "p0_events_test.h"
 
+#include "bip39.h"
+#include "progress_api.h"
+
 /*****************************************************************************
  * EXTERN VARIABLES
  *****************************************************************************/
@@ -69,6 +72,8 @@
  * PRIVATE MACROS AND DEFINES
  *****************************************************************************/
 #define P0_UNIT_TESTS_TIMEOUT_5S (5 * 1000)
+// Yield at which the host abort is raised during the seed derivation
+#define P0_UNIT_TESTS_ABORT_AT_YIELD 8
 
 /*****************************************************************************
  * PRIVATE TYPEDEFS
@@ -77,6 +82,7 @@
 /*****************************************************************************
  * STATIC VARIABLES
  *****************************************************************************/
+static uint32_t seed_derivation_yields = 0;
 
 /*****************************************************************************
  * GLOBAL VARIABLES
@@ -85,10 +91,22 @@
 /*****************************************************************************
  * STATIC FUNCTION PROTOTYPES
  *****************************************************************************/
+/**
+ * @brief Yield callback of the seed derivation which raises a host abort at
+ * P0_UNIT_TESTS_ABORT_AT_YIELD, as the communication module would
+ */
+static bool abort_seed_derivation(uint32_t current, uint32_t total);
 
 /*****************************************************************************
  * STATIC FUNCTIONS
  *****************************************************************************/
+static bool abort_seed_derivation(uint32_t current, uint32_t total) {
+  seed_derivation_yields++;
+  if (P0_UNIT_TESTS_ABORT_AT_YIELD == seed_derivation_yields) {
+    p0_set_abort_evt(true);
+  }
+  return progress_api_yield(current, total);
+}
 
 /*****************************************************************************
  * GLOBAL FUNCTIONS
@@ -230,3 +248,43 @@ TEST(p0_events_test, inactivity_refresh_on_joystick_movement) {
   p0_reset_evt();
   return;
 }
+
+TEST(p0_events_test, abort_during_seed_derivation) {
+  const char *mnemonic =
+      "abandon abandon abandon abandon abandon abandon abandon abandon "
+      "abandon abandon abandon about";
+  const uint8_t expected_seed[64] = {
+      0xc5, 0x52, 0x57, 0xc3, 0x60, 0xc0, 0x7c, 0x72, 0x02, 0x9a, 0xeb,
+      0xc1, 0xb5, 0x3c, 0x05, 0xed, 0x03, 0x62, 0xad, 0xa3, 0x8e, 0xad,
+      0x3e, 0x3e, 0x9e, 0xfa, 0x37, 0x08, 0xe5, 0x34, 0x95, 0x53, 0x1f,
+      0x09, 0xa6, 0x98, 0x75, 0x99, 0xd1, 0x82, 0x64, 0xc1, 0xe1, 0xc9,
+      0x2f, 0x2c, 0xf1, 0x41, 0x63, 0x0c, 0x7a, 0x3c, 0x4a, 0xb7, 0xc8,
+      0x1b, 0x2f, 0x00, 0x16, 0x98, 0xe7, 0x46, 0x3b, 0x04};
+  const uint8_t zero_seed[64] = {0};
+  uint8_t seed[64] = {0};
+  p0_evt_t p0_evt;
+
+  p0_ctx_init(P0_UNIT_TESTS_TIMEOUT_5S);
+  seed_derivation_yields = 0;
+
+  /* The derivation stops at the yield that sees the abort */
+  TEST_ASSERT_EQUAL(0,
+                    mnemonic_to_seed_yield(
+                        mnemonic, "TREZOR", seed, abort_seed_derivation));
+  TEST_ASSERT_EQUAL(P0_UNIT_TESTS_ABORT_AT_YIELD, seed_derivation_yields);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(zero_seed, seed, sizeof(seed));
+
+  /* The abort is left pending for the flow to handle */
+  TEST_ASSERT(p0_get_evt(&p0_evt) == true);
+  TEST_ASSERT(p0_evt.abort_evt == true);
+
+  p0_ctx_destroy();
+  p0_reset_evt();
+
+  /* Once the event is handled, the next derivation runs to completion */
+  TEST_ASSERT_EQUAL(
+      1, mnemonic_to_seed_yield(mnemonic, "TREZOR", seed, progress_api_yield));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_seed, seed, sizeof(seed));
+
+  return;
+}
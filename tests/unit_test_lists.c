@@ -78,6 +78,7 @@ TEST_GROUP_RUNNER(p0_events_test) {
   RUN_TEST_CASE(p0_events_test, abort_evt);
   RUN_TEST_CASE(p0_events_test, abort_inactivity_race);
   RUN_TEST_CASE(p0_events_test, inactivity_refresh_on_joystick_movement);
+  RUN_TEST_CASE(p0_events_test, abort_during_seed_derivation);
 }
 
 TEST_GROUP_RUNNER(usb_evt_api_test) {
@@ -86,6 +87,7 @@ TEST_GROUP_RUNNER(usb_evt_api_test) {
   RUN_TEST_CASE(usb_evt_api_test, consume_and_respond)
   RUN_TEST_CASE(usb_evt_api_test, stitch_data_chunks)
   RUN_TEST_CASE(usb_evt_api_test, send_data_chunks)
+  RUN_TEST_CASE(usb_evt_api_test, pipelined_cmd)
 }
 
 TEST_GROUP_RUNNER(ui_events_test) {
@@ -110,6 +112,29 @@ TEST_GROUP_RUNNER(nfc_events_manual_test) {
 }
 #endif
 
+#if USE_SIMULATOR == 1
+TEST_GROUP_RUNNER(sim_usb_session_test) {
+  RUN_TEST_CASE(sim_usb_session_test, packets_round_trip);
+  RUN_TEST_CASE(sim_usb_session_test, inputs_round_trip);
+  RUN_TEST_CASE(sim_usb_session_test, skips_non_events);
+  RUN_TEST_CASE(sim_usb_session_test, rejects_unformattable_events);
+}
+
+TEST_GROUP_RUNNER(nfc_whole_msg_test) {
+  RUN_TEST_CASE(nfc_whole_msg_test, chained_command_and_response);
+  RUN_TEST_CASE(nfc_whole_msg_test, response_bounded_by_capacity);
+}
+
+TEST_GROUP_RUNNER(nfc_selective_retrieve_test) {
+  RUN_TEST_CASE(nfc_selective_retrieve_test, selected_fields_only);
+  RUN_TEST_CASE(nfc_selective_retrieve_test,
+                full_retrieve_without_capability);
+  RUN_TEST_CASE(nfc_selective_retrieve_test, full_retrieve_on_unknown_p1);
+  RUN_TEST_CASE(nfc_selective_retrieve_test,
+                selected_fields_checksum_verified);
+}
+#endif
+
 TEST_GROUP_RUNNER(array_lists_tests) {
   RUN_TEST_CASE(array_list_tests, insert_multiple);
   RUN_TEST_CASE(array_list_tests, insert_in_full_array);
@@ -221,4 +246,67 @@ TEST_GROUP_RUNNER(utils_tests) {
   RUN_TEST_CASE(utils_tests, escape_string_invalid_non_print_utf);
   RUN_TEST_CASE(utils_tests, escape_string_short_out_buff);
   RUN_TEST_CASE(utils_tests, escape_string_invalid_args);
-}
\ No newline at end of file
+}
+
+TEST_GROUP_RUNNER(wallet_utilities_tests) {
+  RUN_TEST_CASE(wallet_utilities_tests, seed_tag_known_vector);
+  RUN_TEST_CASE(wallet_utilities_tests, seed_tag_keyed_by_wallet_id);
+}
+
+TEST_GROUP_RUNNER(flash_struct_tests) {
+  RUN_TEST_CASE(flash_struct_tests, seed_tag_round_trip);
+}
+
+TEST_GROUP_RUNNER(lz4_block_tests) {
+  RUN_TEST_CASE(lz4_block_tests, decompress_repeated_scripts);
+  RUN_TEST_CASE(lz4_block_tests, decompress_in_place);
+  RUN_TEST_CASE(lz4_block_tests, decompress_in_place_overrun);
+  RUN_TEST_CASE(lz4_block_tests, decompress_invalid_offset);
+  RUN_TEST_CASE(lz4_block_tests, decompress_output_too_small);
+  RUN_TEST_CASE(lz4_block_tests, decompress_truncated);
+}
+
+TEST_GROUP_RUNNER(background_jobs_tests) {
+  RUN_TEST_CASE(background_jobs_tests, round_robin);
+  RUN_TEST_CASE(background_jobs_tests, finish_in_foreground);
+  RUN_TEST_CASE(background_jobs_tests, cancel);
+  RUN_TEST_CASE(background_jobs_tests, finish_without_submit);
+}
+
+TEST_GROUP_RUNNER(packet_ring_tests) {
+  RUN_TEST_CASE(packet_ring_tests, fifo_order);
+  RUN_TEST_CASE(packet_ring_tests, overflow_drops_newest);
+  RUN_TEST_CASE(packet_ring_tests, pop_empty);
+#if USE_SIMULATOR == 1
+  RUN_TEST_CASE(packet_ring_tests, concurrent_producer);
+#endif
+}
+
+TEST_GROUP_RUNNER(shamir_tests) {
+  RUN_TEST_CASE(shamir_tests, stream_split_recover_pairs);
+  RUN_TEST_CASE(shamir_tests, stream_split_is_deterministic_per_block);
+  RUN_TEST_CASE(shamir_tests, stream_split_threshold_2);
+  RUN_TEST_CASE(shamir_tests, stream_split_threshold_3);
+  RUN_TEST_CASE(shamir_tests, stream_split_threshold_4);
+}
+
+TEST_GROUP_RUNNER(hash_fast_path_tests) {
+  RUN_TEST_CASE(hash_fast_path_tests, sha256_short_matches_generic);
+  RUN_TEST_CASE(hash_fast_path_tests, sha256_fixed_lengths);
+  RUN_TEST_CASE(hash_fast_path_tests, hash160_matches_generic);
+  RUN_TEST_CASE(hash_fast_path_tests, sha512_32_matches_generic);
+  RUN_TEST_CASE(hash_fast_path_tests, sha512_32_fips_vectors);
+}
+
+TEST_GROUP_RUNNER(rfc6979_tests) {
+  RUN_TEST_CASE(rfc6979_tests, known_vectors);
+  RUN_TEST_CASE(rfc6979_tests, prepared_key_signs_many_digests);
+}
+
+TEST_GROUP_RUNNER(ecdsa_table_tests) {
+  RUN_TEST_CASE(ecdsa_table_tests, multiply_matches_point_multiply);
+  RUN_TEST_CASE(ecdsa_table_tests, verify_accepts_valid_signatures);
+  RUN_TEST_CASE(ecdsa_table_tests, verify_rejects_wrong_key);
+  RUN_TEST_CASE(ecdsa_table_tests, verify_rejects_tampered_signature);
+  RUN_TEST_CASE(ecdsa_table_tests, init_rejects_invalid_key);
+}
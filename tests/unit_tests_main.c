@@ -87,10 +87,16 @@ void RunAllTests(void) {
   RUN_TEST_GROUP(nfc_events_test);
 #ifdef NFC_EVENT_CARD_DETECT_MANUAL_TEST
   RUN_TEST_GROUP(nfc_events_manual_test);
+#endif
+#if USE_SIMULATOR == 1
+  RUN_TEST_GROUP(sim_usb_session_test);
+  RUN_TEST_GROUP(nfc_whole_msg_test);
+  RUN_TEST_GROUP(nfc_selective_retrieve_test);
 #endif
   RUN_TEST_GROUP(xpub);
   RUN_TEST_GROUP(array_lists_tests);
   RUN_TEST_GROUP(flow_engine_tests);
+  RUN_TEST_GROUP(background_jobs_tests);
   RUN_TEST_GROUP(manager_api_test);
   RUN_TEST_GROUP(btc_txn_helper_test);
   RUN_TEST_GROUP(btc_helper_test);
@@ -103,6 +109,14 @@ void RunAllTests(void) {
   RUN_TEST_GROUP(near_txn_user_verification_test);
 #endif
   RUN_TEST_GROUP(utils_tests);
+  RUN_TEST_GROUP(wallet_utilities_tests);
+  RUN_TEST_GROUP(flash_struct_tests);
+  RUN_TEST_GROUP(lz4_block_tests);
+  RUN_TEST_GROUP(packet_ring_tests);
+  RUN_TEST_GROUP(shamir_tests);
+  RUN_TEST_GROUP(hash_fast_path_tests);
+  RUN_TEST_GROUP(rfc6979_tests);
+  RUN_TEST_GROUP(ecdsa_table_tests);
 }
 
 /**
@@ -173,6 +173,64 @@ TEST(usb_evt_api_test, send_data_chunks) {
   // TODO: Add test
 }
 
+static void process_cmd_packet(uint16_t seq_no, const uint8_t *payload,
+                               uint8_t size) {
+  packet_t packet = {0};
+  packet.header.chunk_number = 1;
+  packet.header.total_chunks = 1;
+  packet.header.sequence_no = seq_no;
+  packet.header.packet_type = 2;    // PKT_TYPE_CMD
+  packet.header.payload_length = size;
+  packet.payload = payload;
+  packet.interface = COMM_LIBUSB__HID;
+  comm_process_packet(&packet);
+}
+
+/**
+ * @brief Test upload of a command while the previous one is processed.
+ * @details The host can upload one command while the application processes
+ * the current one. It is delivered only after the current command is
+ * responded to, while the response of the current command stays available.
+ */
+TEST(usb_evt_api_test, pipelined_cmd) {
+  // core msg length : app msg length : core msg : app msg
+  const uint8_t first[] = {0, 4, 0, 1, 10, 2, 8, 1, 0x11};
+  const uint8_t second[] = {0, 4, 0, 2, 10, 2, 8, 1, 0x22, 0x33};
+  comm_status_t *status = get_comm_status();
+  usb_event_t usb_evt;
+
+  usb_clear_event();
+  process_cmd_packet(100, first, sizeof(first));
+  TEST_ASSERT_TRUE(usb_get_event(&usb_evt));
+  TEST_ASSERT_EQUAL_UINT8(0x11, usb_evt.p_msg[0]);
+  usb_release_event_buffer();
+
+  // accepted and held while the first command executes
+  process_cmd_packet(101, second, sizeof(second));
+  TEST_ASSERT_EQUAL(CMD_STATE_RECEIVED, status->next_cmd_state);
+  TEST_ASSERT_EQUAL(CMD_STATE_EXECUTING, status->curr_cmd_state);
+  TEST_ASSERT_FALSE(usb_get_event(&usb_evt));
+  // receive progress of the current command is not touched by the next one
+  TEST_ASSERT_EQUAL(sizeof(first), status->curr_cmd_received_length);
+  TEST_ASSERT_EQUAL(sizeof(second), status->next_cmd_received_length);
+  TEST_ASSERT_EQUAL(1, status->next_cmd_chunk_no);
+
+  usb_send_msg(core_msg, 1, data, 1);
+  TEST_ASSERT_EQUAL(100, status->out_seq_no);
+  TEST_ASSERT_NOT_NULL(comm_get_slot(COMM_SLOT_OUTPUT));
+
+  TEST_ASSERT_TRUE(usb_get_event(&usb_evt));
+  TEST_ASSERT_EQUAL(2, usb_evt.msg_size);
+  TEST_ASSERT_EQUAL_UINT8(0x22, usb_evt.p_msg[0]);
+  TEST_ASSERT_EQUAL(101, status->curr_cmd_seq_no);
+  TEST_ASSERT_EQUAL(CMD_STATE_NONE, status->next_cmd_state);
+  TEST_ASSERT_EQUAL(sizeof(second), status->curr_cmd_received_length);
+  TEST_ASSERT_EQUAL(0, status->next_cmd_received_length);
+  // the response of the first command is still held for the host
+  TEST_ASSERT_NOT_NULL(comm_get_slot(COMM_SLOT_OUTPUT));
+  comm_reset_interface();
+}
+
 /**
  * @brief Test the behaviour of usb-comm module due to unexpected
  * calls made by application.